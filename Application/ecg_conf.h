@@ -0,0 +1,84 @@
+#ifndef ECG_CONF_H
+#define ECG_CONF_H
+
+/*
+ * ECG信号链编译期配置，可在编译选项中用 -D 覆盖
+ */
+
+/* 信号链数据类型 0:浮点 1:定点(Q31采集、定点FIR、arm_rfft_q31频谱) */
+#ifndef ECG_USE_FIXED_POINT
+#define ECG_USE_FIXED_POINT 0
+#endif
+
+/* 定点模式下FIR的精度 0:Q31 1:Q15(双MAC，截取高16位输入) */
+#ifndef ECG_FIR_Q15
+#define ECG_FIR_Q15 0
+#endif
+
+/* 流水线各阶段的耗时统计 0:关闭，相关宏展开为空 */
+#ifndef ECG_PROF_ENABLE
+#define ECG_PROF_ENABLE 1
+#endif
+
+/* DSP缓冲区放入单独的链接段，由链接脚本放到CCM RAM，范围为 _sdsp_bss/_edsp_bss
+ * CCM只有CPU能访问，DMA缓冲区不能使用该宏
+ * make DSP_CCM=0 时链接脚本把该段放到SRAM，段与MEM的统计不变，用 BENCH 命令对比两种放置的耗时 */
+#ifndef ECG_DSP_BSS
+#if defined(USE_HAL_DRIVER)
+#define ECG_DSP_BSS __attribute__((section(".bss.dsp")))
+#else
+#define ECG_DSP_BSS
+#endif
+#endif
+
+/*
+ * 放到SRAM中执行的内核，1:启动时随.data从Flash拷贝到SRAM，0:留在Flash经ART执行
+ * 例如 make RAMFUNC="FIR QRS" 或 -DECG_RAMFUNC_FIR=1，每个内核一个开关，与Makefile的RAMFUNC_KERNELS一致
+ * CCM RAM不能取指，只能放SRAM；用 BENCH 命令对比放置前后对应PROF区间的周期数
+ */
+#ifndef ECG_RAMFUNC_FIR
+#define ECG_RAMFUNC_FIR 0 // FIR_filter/FIR_filter_q31/FIR_filter_q15
+#endif
+#ifndef ECG_RAMFUNC_FFT
+#define ECG_RAMFUNC_FFT 0 // WELCH_Transform/WELCH_Accumulate，FFT库函数本身仍在Flash
+#endif
+#ifndef ECG_RAMFUNC_IIR
+#define ECG_RAMFUNC_IIR 0 // IIR_Process/IIR_ProcessQ31
+#endif
+#ifndef ECG_RAMFUNC_LMS
+#define ECG_RAMFUNC_LMS 0 // LMS_Process
+#endif
+#ifndef ECG_RAMFUNC_GZ
+#define ECG_RAMFUNC_GZ 0 // GZ_Process
+#endif
+#ifndef ECG_RAMFUNC_DECIM
+#define ECG_RAMFUNC_DECIM 0 // FIR_Decim_Process/FIR_Decim_ProcessQ31
+#endif
+#ifndef ECG_RAMFUNC_WSTAT
+#define ECG_RAMFUNC_WSTAT 0 // WSTAT_Push
+#endif
+#ifndef ECG_RAMFUNC_QRS
+#define ECG_RAMFUNC_QRS 0 // QRS_Process
+#endif
+#ifndef ECG_RAMFUNC_UNPACK
+#define ECG_RAMFUNC_UNPACK 0 // ADS1292R_UnpackFrames
+#endif
+
+/* 合成ECG经DAC1(PA4)输出，用于硬件在环测试，需外接分压到ADS1292R输入 */
+#ifndef ECG_SYNTH_DAC
+#define ECG_SYNTH_DAC 0
+#endif
+
+#define ECG_RAMFUNC_CAT_(a, b) a##b
+#define ECG_RAMFUNC_CAT(a, b) ECG_RAMFUNC_CAT_(a, b)
+#ifdef USE_HAL_DRIVER
+#define ECG_RAMFUNC_SEL_1 __attribute__((section(".RamFunc"), noinline))
+#else
+#define ECG_RAMFUNC_SEL_1
+#endif
+#define ECG_RAMFUNC_SEL_0
+
+/* 用法：ECG_RAMFUNC(FIR) float FIR_filter(FIR_t *fir, float input) {...} */
+#define ECG_RAMFUNC(kernel) ECG_RAMFUNC_CAT(ECG_RAMFUNC_SEL_, ECG_RAMFUNC_##kernel)
+
+#endif // !ECG_CONF_H
@@ -1,13 +1,21 @@
 #include "cmsis_os.h"
 #include "ads1292r.h"
+#include "ads1292r_frame.h"
 #include "usart.h"
 #include "stdio.h"
 #include "string.h"
-#include "FIR.h"
-#include "arm_math.h"
+#include "ecg_prof.h"
+#include "ecg_mem.h"
 #include "lcd.h"
+#include "bsp_usart.h"
+#include "ecg_cmd.h"
+#include "ecg_core.h"
+
+/*
+ * ECG任务：信号处理在 Module/ECG/ecg_core.c 中，
+ * 这里只负责ADS1292R采样、LCD绘图、串口遥测与命令，作为核心的固件端接口实现
+ */
 
-#define FFT_LENGTH 1024 // 设定FFT的点数，根据你的需求调整
 #define LCD_WIDTH 320
 #define LCD_HEIGHT 480
 #define ECG_X_START 50
@@ -19,214 +27,144 @@
 #define FFT_WIDTH (LCD_WIDTH - FFT_X_START)
 #define FFT_HEIGHT 120
 
-static int16_t ecg_buffer[FFT_LENGTH];          // 环形缓冲区，用于存储ECG数据
-static int16_t ecg_max = 0;                     // 最大值
-static int16_t ecg_min = 0;                     // 最小值
-static uint16_t ecg_diff = 0;                   // 最大最小值之差
-static uint16_t buffer_index = 0;               // 缓冲区索引，用于跟踪最新数据位置
-static float FFT_InputBuf[FFT_LENGTH];          // 用于存储输入信号（复数形式）
-static float FFT_OutputBuf[FFT_LENGTH];         // 用于存储FFT输出（复数形式）
-static arm_rfft_fast_instance_f32 fft_instance; // FFT实例
-
-static uint8_t ads1292_raw_data[9];
-static int16_t ads1292_ecg_data[2];
-static int32_t ads1292_ecg_data_temp[2];
-static int16_t FIR_filtered_data = 0;
-
-static float ecg_frequency = 0.0f;
-static float ecg_vol = 0.0f;
-
+static uint8_t ads1292_raw_data[ADS1292R_FRAME_SIZE];
 static uint16_t current_index = ECG_X_START;
 static uint16_t last_ecg_y = ECG_Y_START - ECG_HEIGHT / 2;
-static uint8_t read_count = 0; // 十次循环执行一次FFT
+static uint8_t cmd_rx_buf[32]; // 串口命令接收暂存
+static uint8_t last_key_mode = 0;
 
 extern uint8_t ads1292_flag;
+extern uint32_t ads1292_drdy_stamp;
 extern uint8_t device_ID;
 extern uint8_t key_mode;
 
-static void ecg_data_process(void);
-void update_ecg_buffer(int16_t new_ecg_data);
-void FFT_Process(void);
-void CalculateSignalFrequency(void);
-void Draw_ECG(void);
-void Draw_FFT(void);
+static void ecg_cmd_process(void);
+static uint8_t ecg_read_frame(uint8_t *raw, uint32_t *stamp);
+static void ecg_telemetry(const char *name, long value);
+static void ecg_show_heart_rate(uint32_t bpm);
+static void ecg_show_peak_to_peak(uint32_t p2p);
+void Draw_ECG(int32_t y);
+void Draw_FFT(const ecg_spec_t *spec, uint16_t columns);
 void Draw_ECG_UI(void);
 void Draw_FFT_UI(void);
+#if ECG_SYNTH_DAC
+#include "ecg_synth.h"
+void SYNTH_DAC_Start(const SYNTH_Param_t *param);
+#endif
+
+/* 信号处理核心的固件端接口，clock_hz 在任务启动时填入 */
+static ECG_Port_t ecg_port = {
+    .read_frame = ecg_read_frame,
+    .draw_ecg = Draw_ECG,
+    .ecg_height = ECG_HEIGHT,
+    .draw_spectrum = Draw_FFT,
+    .spectrum_width = FFT_WIDTH,
+    .show_heart_rate = ecg_show_heart_rate,
+    .show_peak_to_peak = ecg_show_peak_to_peak,
+    .telemetry = ecg_telemetry,
+    .now = PROF_Now,
+};
 
 void ECGTask(void *argument)
 {
+    ecg_port.clock_hz = SystemCoreClock;
+
     LCD_Clear(GBLUE);
-    arm_rfft_fast_init_f32(&fft_instance, FFT_LENGTH);
+    ECG_Core_Init(&ecg_port);
     Draw_ECG_UI();
     Draw_FFT_UI();
+    USART1_RxStart();
+#if ECG_SYNTH_DAC
+    SYNTH_DAC_Start(NULL);
+#endif
 
     for (;;)
     {
-        if (ads1292_flag == 1)
+        ecg_cmd_process();
+        MEM_Report(ecg_config.telemetry & ECG_TLM_MEM);
+
+        // 有样本时立即处理下一帧，没有时等待DRDY唤醒，超时1个节拍以便处理串口命令
+        // 固定的osDelay(1)在1kHz节拍下每帧至少等1ms，1000SPS时会丢掉一半样本
+        if (!ECG_Core_Poll())
         {
-            ADS1292R_ReadData(ads1292_raw_data);
-            ads1292_flag = 0;
-            ecg_data_process();
-
-            // FIR 滤波
-            FIR_filtered_data = FIR_filter(ads1292_ecg_data[0]);
-            printf("{FIR_filtered_data}");
-            printf("%d\n", FIR_filtered_data);
-            update_ecg_buffer(FIR_filtered_data);
-            Draw_ECG();
-            // 十次循环读取一次
-            if (read_count > 9)
-            {
-                read_count = 0;
-                FFT_Process();
-                Draw_FFT();
-                CalculateSignalFrequency();
-            }
-            read_count++;
-
-            // // 通过 UART 发送字符串
-            // char buffer[5] = "abcde";
-            // HAL_UART_Transmit(&huart1, (uint8_t *)buffer, strlen(buffer), HAL_MAX_DELAY);
+            ECG_Core_Idle();
+            osThreadFlagsWait(ECG_FLAG_DRDY, osFlagsWaitAny, 1);
         }
-        osDelay(1);
-        LCD_Fill(FFT_X_START + 1, FFT_Y_START - FFT_HEIGHT, FFT_X_START + FFT_WIDTH, FFT_Y_START - 1, GBLUE);
     }
 }
 
 /**
- * @brief ECG 数据处理，单次采集的CH1和CH2数据拼接并裁剪为16位数据
+ * @brief 采样源：DRDY到来后读取一帧
  */
-static void ecg_data_process(void)
+static uint8_t ecg_read_frame(uint8_t *raw, uint32_t *stamp)
 {
-    for (uint8_t n = 0; n < 2; n++) // 单次采集的CH1和CH2数据存入ADS1292R_ECG_BUFFER
-    {
-        ads1292_ecg_data_temp[n] = ads1292_raw_data[3 + 3 * n];
-        ads1292_ecg_data_temp[n] = ads1292_ecg_data_temp[n] << 8;
-        ads1292_ecg_data_temp[n] |= ads1292_raw_data[3 + 3 * n + 1];
-        ads1292_ecg_data_temp[n] = ads1292_ecg_data_temp[n] << 8;
-        ads1292_ecg_data_temp[n] |= ads1292_raw_data[3 + 3 * n + 2];
-    }
-
-    ads1292_ecg_data_temp[0] = ads1292_ecg_data_temp[0] >> 8; // 舍去低8位
-    ads1292_ecg_data_temp[1] = ads1292_ecg_data_temp[1] >> 8;
-
-    ads1292_ecg_data_temp[0] &= 0xffff; // 消除补码算数移位对数据影响
-    ads1292_ecg_data_temp[1] &= 0xffff;
-
-    ads1292_ecg_data[0] = (int16_t)ads1292_ecg_data_temp[0];
-    ads1292_ecg_data[1] = (int16_t)ads1292_ecg_data_temp[1];
-
-    ecg_vol = ads1292_ecg_data[0] * 2.42f / 32767.0f;
-
-    if (ads1292_ecg_data[0] > 50)
-    {
-        ads1292_ecg_data[0] = -10;
-    }
-    else if (ads1292_ecg_data[0] < -50)
-    {
-        ads1292_ecg_data[0] = -10;
-    }
-
-    printf("{ecg_channel_1}");
-    printf("%d\n", ads1292_ecg_data[0]);
-    // printf("{ecg_channel_2}");
-    // printf("%d\n", ads1292_ecg_data[1]);
+    if (ads1292_flag != 1)
+        return 0;
+
+    PROF_BEGIN(ACQ);
+    *stamp = ads1292_drdy_stamp;
+    ADS1292R_ReadData(ads1292_raw_data);
+    ads1292_flag = 0;
+    memcpy(raw, ads1292_raw_data, ADS1292R_FRAME_SIZE);
+    PROF_END(ACQ);
+    return 1;
 }
 
 /**
- * @brief 将ECG数据存入环形缓冲区
+ * @brief 遥测：按上位机格式 "{name}value" 输出一行
  */
-void update_ecg_buffer(int16_t new_ecg_data)
+static void ecg_telemetry(const char *name, long value)
 {
-    // 将新的ECG数据存入缓冲区
-    ecg_buffer[buffer_index] = new_ecg_data;
-
-    // 更新缓冲区索引（循环）
-    buffer_index = (buffer_index + 1) % FFT_LENGTH;
-
-    // 计算ecg_buffer的最大最小之差
-    if (new_ecg_data > ecg_max)
-    {
-        ecg_max = new_ecg_data;
-    }
-    if (new_ecg_data < ecg_min)
-    {
-        ecg_min = new_ecg_data;
-    }
-    ecg_diff = ecg_max - ecg_min;
+    printf("{%s}", name);
+    printf("%ld\n", value);
 }
 
 /**
- * @brief FFT变换
+ * @brief 处理串口命令，并把需要改动硬件的配置应用到ADS1292R
  */
-void FFT_Process(void)
+static void ecg_cmd_process(void)
 {
-    // 读取ecg_buffer到FFT_InputBuf
-    for (int i = 0; i < FFT_LENGTH; i++)
+    uint16_t len;
+    uint8_t apply = 0;
+    uint8_t reg_addr, reg_value;
+
+    // 按键切换显示模式
+    if (key_mode != last_key_mode)
     {
-        FFT_InputBuf[i] = (float)ecg_buffer[(buffer_index + i) % FFT_LENGTH];
+        last_key_mode = key_mode;
+        ecg_config.display_mode = key_mode;
     }
 
-    /* 执行 FFT 计算 */
-    arm_rfft_fast_f32(&fft_instance, FFT_InputBuf, FFT_OutputBuf, 0);
-
-    /* 计算幅值谱 */
-    FFT_OutputBuf[0] = fabsf(FFT_OutputBuf[0]); // 直流分量，实数
-
-    for (int i = 1; i < FFT_LENGTH / 2; i++)
+    while ((len = USART1_RxRead(cmd_rx_buf, sizeof(cmd_rx_buf))) > 0)
     {
-        float real = FFT_OutputBuf[2 * i];                   // 实部
-        float imag = FFT_OutputBuf[2 * i + 1];               // 虚部
-        FFT_OutputBuf[i] = sqrtf(real * real + imag * imag); // 计算幅值
+        apply |= ECG_Cmd_Input(cmd_rx_buf, len);
     }
-}
-
-/**
- * @brief 计算频率
- */
-void CalculateSignalFrequency(void)
-{
-    float maxValue = 0.0f;
-    int maxIndex = 0;
 
-    for (int i = 25; i < FFT_LENGTH / 2; i++)
+    if (apply & ECG_APPLY_RATE)
     {
-        if (FFT_OutputBuf[i] > maxValue)
-        {
-            maxValue = FFT_OutputBuf[i];
-            maxIndex = i;
-        }
+        ADS1292R_SetSampleRate(ecg_config.sample_rate);
+        ECG_Core_SetSampleRate(ecg_config.sample_rate);
     }
-
-    float frequency = (1000 * maxIndex) / (float)FFT_LENGTH;
-
-    // 在 ecg 数据中找到最大值和最小值
-    uint16_t ecgMax = 0;
-    uint16_t ecgMin = 50;
-
-    for (int i = 0; i < FFT_LENGTH; i++)
+    if (apply & ECG_APPLY_REG)
     {
-        if (ecg_buffer[i] > ecg_max)
-        {
-            ecgMax = ecg_buffer[i];
-        }
-        if (ecg_buffer[i] < ecg_min)
-        {
-            ecgMin = ecg_buffer[i];
-        }
+        while (ECG_Cmd_RegPop(&reg_addr, &reg_value))
+            ADS1292R_WriteReg(reg_addr, reg_value);
     }
+    if (apply)
+    {
+        ads1292_flag = 0; // 丢弃配置切换前的样本
+    }
+}
 
-    // 计算峰峰值
-    uint16_t ecgPeakToPeak = ecgMax - ecgMin;
-
-    // // 将 ADC 值转换为电压值，假设 ADC 参考电压为 3.3V
-    // float voltage = (float)ecgPeakToPeak * 2.42f / 32767.0f;
-
-    LCD_ShowString(90, 25, 200, 24, 24, (uint8_t *)"Frequency:");
-    LCD_ShowNum(210, 25, (uint32_t)frequency, 4, 24);
+static void ecg_show_heart_rate(uint32_t bpm)
+{
+    LCD_ShowNum(210, 25, bpm, 4, 24);
+}
 
+static void ecg_show_peak_to_peak(uint32_t p2p)
+{
     LCD_ShowString(90, 55, 200, 24, 24, (uint8_t *)"PeakToPeak:");
-    LCD_ShowNum(225, 55, (uint32_t)ecgPeakToPeak, 4, 24);
+    LCD_ShowNum(225, 55, p2p, 4, 24);
 }
 
 void Draw_ECG_UI()
@@ -239,6 +177,10 @@ void Draw_ECG_UI()
     LCD_ShowNum(10, ECG_Y_START - ECG_HEIGHT, 4095, 4, 16);
 
     LCD_ShowString(ECG_X_START + 80, ECG_Y_START + 10, 200, 24, 24, (uint8_t *)"ECG Line");
+
+    // FFT最大值对应的频率不是心率，这里显示QRS检测得到的心率
+    LCD_ShowString(90, 25, 200, 24, 24, (uint8_t *)"HeartRate:");
+    LCD_ShowNum(210, 25, 0, 4, 24);
 }
 
 void Draw_FFT_UI()
@@ -255,11 +197,11 @@ void Draw_FFT_UI()
 
 /**
  * @brief 绘制ECG波形
+ * @param y: 距横轴的高度，已由核心按窗口内最小/最大值缩放到 0~ECG_HEIGHT-1
  */
-void Draw_ECG()
+void Draw_ECG(int32_t y)
 {
-    // 计算当前点的y坐标，基于FIR_filtered_data（后期换）
-    uint16_t current_y = ECG_Y_START - ECG_HEIGHT / 2 - FIR_filtered_data; // 需要根据实际情况处理 FIR_filtered_data 映射
+    int32_t current_y = ECG_Y_START - y;
 
     // 限制y坐标范围在ECG_Y_START-ECG_HEIGHT到ECG_Y_START之间
     if (current_y < ECG_Y_START - ECG_HEIGHT)
@@ -277,7 +219,7 @@ void Draw_ECG()
     // 绘制当前点与上一个点之间的线
     if (current_index > 0)
     {
-        LCD_DrawLine(current_x - 1, last_ecg_y, current_x, current_y);
+        LCD_DrawLine(current_x - 1, last_ecg_y, current_x, (uint16_t)current_y);
     }
 
     // 更新上一点的y坐标
@@ -292,37 +234,19 @@ void Draw_ECG()
     }
 }
 
-void Draw_FFT()
+/**
+ * @brief 清除上一帧后绘制频谱
+ * @param spec: 每列的显示值，已归一化到0~1
+ * @param columns: 列数，即FFT_WIDTH
+ */
+void Draw_FFT(const ecg_spec_t *spec, uint16_t columns)
 {
-    float x, y;
-    float x_scale = (float)FFT_WIDTH / (FFT_LENGTH / 2); // X轴缩放比例
-    float y_scale;
-    float max_value = 0.0f;
-
-    // 寻找幅值最大值，用于Y轴缩放
-    for (int i = 0; i < FFT_LENGTH / 2; i++)
-    {
-        if (FFT_OutputBuf[i] > max_value)
-        {
-            max_value = FFT_OutputBuf[i];
-        }
-    }
-
-    // 防止除以零
-    if (max_value == 0)
-    {
-        max_value = 1.0f;
-    }
-
-    y_scale = (float)FFT_HEIGHT / max_value;
-
-    // 绘制频谱
-    for (int i = 0; i < FFT_LENGTH / 2; i++)
+    LCD_Fill(FFT_X_START + 1, FFT_Y_START - FFT_HEIGHT, FFT_X_START + FFT_WIDTH, FFT_Y_START - 1, GBLUE);
+    for (uint16_t i = 0; i < columns; i++)
     {
-        x = FFT_X_START + i * x_scale;
-        y = FFT_Y_START - FFT_OutputBuf[i] * y_scale;
+        uint16_t x = FFT_X_START + i;
+        uint16_t y = FFT_Y_START - (uint16_t)(spec[i] * FFT_HEIGHT);
 
-        // 将浮点坐标转换为整数坐标进行绘制
-        LCD_DrawLine((uint16_t)x, FFT_Y_START, (uint16_t)x, (uint16_t)y);
+        LCD_DrawLine(x, FFT_Y_START, x, y);
     }
-}
\ No newline at end of file
+}
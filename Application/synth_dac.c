@@ -0,0 +1,79 @@
+#include "ecg_conf.h"
+
+#if ECG_SYNTH_DAC
+
+#include "dac.h"
+#include "tim.h"
+#include "ecg_synth.h"
+
+/*
+ * 合成ECG经DAC输出：TIM6 TRGO触发DAC通道1，DMA1_Stream5循环搬运，
+ * 半满/全满中断中填充另一半缓冲区
+ */
+
+#define SYNTH_DAC_FS 1000         // DAC更新率，Hz，高于ADS1292R采样率
+#define SYNTH_DAC_BUF_SIZE 64     // 两个半区，每半32点
+#define SYNTH_DAC_MID 2048        // 0mV对应的DAC码值
+#define SYNTH_DAC_COUNTS_PER_MV 1000.0f // 1mV对应约0.8V，外部分压1000:1后送入ADS1292R
+
+static uint16_t synth_dac_buf[SYNTH_DAC_BUF_SIZE]; // DMA访问，不能放CCM
+static SYNTH_t synth_dac;
+
+/**
+ * @brief 生成半个缓冲区的样本
+ */
+static void synth_dac_fill(uint16_t *buf, uint16_t len)
+{
+    for (uint16_t i = 0; i < len; i++)
+    {
+        float v = SYNTH_DAC_MID + SYNTH_Next(&synth_dac) * SYNTH_DAC_COUNTS_PER_MV;
+
+        if (v < 0.0f)
+            v = 0.0f;
+        else if (v > 4095.0f)
+            v = 4095.0f;
+        buf[i] = (uint16_t)v;
+    }
+}
+
+/**
+ * @brief 启动合成ECG输出，参数为 NULL 时使用 75bpm、含HRV与少量工频干扰的默认信号
+ */
+void SYNTH_DAC_Start(const SYNTH_Param_t *param)
+{
+    SYNTH_Param_t p;
+
+    if (param != NULL)
+    {
+        p = *param;
+        p.fs = SYNTH_DAC_FS;
+    }
+    else
+    {
+        SYNTH_DefaultParam(&p, SYNTH_DAC_FS);
+        p.hr_mean = 75.0f;
+        p.hrv_std = 0.05f;
+        p.mains_amp = 0.05f;
+        p.wander_amp = 0.1f;
+        p.noise_std = 0.01f;
+    }
+    SYNTH_Init(&synth_dac, &p);
+    synth_dac_fill(synth_dac_buf, SYNTH_DAC_BUF_SIZE);
+
+    // TIM6计数频率为1MHz
+    __HAL_TIM_SET_AUTORELOAD(&htim6, 1000000 / SYNTH_DAC_FS - 1);
+    HAL_DAC_Start_DMA(&hdac, DAC_CHANNEL_1, (uint32_t *)synth_dac_buf, SYNTH_DAC_BUF_SIZE, DAC_ALIGN_12B_R);
+    HAL_TIM_Base_Start(&htim6);
+}
+
+void HAL_DAC_ConvHalfCpltCallbackCh1(DAC_HandleTypeDef *hdac)
+{
+    synth_dac_fill(synth_dac_buf, SYNTH_DAC_BUF_SIZE / 2);
+}
+
+void HAL_DAC_ConvCpltCallbackCh1(DAC_HandleTypeDef *hdac)
+{
+    synth_dac_fill(synth_dac_buf + SYNTH_DAC_BUF_SIZE / 2, SYNTH_DAC_BUF_SIZE / 2);
+}
+
+#endif
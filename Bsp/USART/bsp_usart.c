@@ -0,0 +1,69 @@
+#include "bsp_usart.h"
+
+static uint8_t usart1_rx_buf[USART1_RX_BUF_SIZE]; // DMA循环写入
+static volatile uint16_t usart1_rx_head = 0;       // DMA写指针，由中断更新
+static uint16_t usart1_rx_tail = 0;                // 读指针，仅任务中使用
+static volatile uint8_t usart1_rx_restart = 0;     // 出错后中断重启了DMA，写指针回到0，由任务清零读指针
+
+/**
+ * @brief  启动USART1循环DMA接收
+ * @note   DMA工作在循环模式(usart.c中配置)，空闲线、半满、全满都会触发 HAL_UARTEx_RxEventCallback
+ */
+void USART1_RxStart(void)
+{
+    usart1_rx_head = 0;
+    usart1_rx_tail = 0;
+    HAL_UARTEx_ReceiveToIdle_DMA(&huart1, usart1_rx_buf, USART1_RX_BUF_SIZE);
+}
+
+/**
+ * @brief  从环形缓冲区取出新数据
+ * @param  data: 输出缓冲区
+ * @param  max_len: 输出缓冲区大小
+ * @return 取出的字节数
+ */
+uint16_t USART1_RxRead(uint8_t *data, uint16_t max_len)
+{
+    uint16_t head;
+    uint16_t len = 0;
+
+    // 先清标志再读写指针：其间再次出错时标志会重新置位，下次调用再对齐
+    if (usart1_rx_restart)
+    {
+        usart1_rx_restart = 0;
+        usart1_rx_tail = 0;
+    }
+    head = usart1_rx_head;
+
+    while (usart1_rx_tail != head && len < max_len)
+    {
+        data[len++] = usart1_rx_buf[usart1_rx_tail];
+        usart1_rx_tail = (usart1_rx_tail + 1) % USART1_RX_BUF_SIZE;
+    }
+    return len;
+}
+
+/**
+ * @brief  接收事件回调，Size为DMA在缓冲区中的当前位置
+ */
+void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size)
+{
+    if (huart->Instance == USART1)
+    {
+        usart1_rx_head = Size % USART1_RX_BUF_SIZE;
+    }
+}
+
+/**
+ * @brief  出错(如ORE)时HAL会终止接收，这里重新启动
+ * @note   中断中不写读指针，只把写指针归0并置位标志，读指针由任务在 USART1_RxRead 中对齐
+ */
+void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart)
+{
+    if (huart->Instance == USART1)
+    {
+        usart1_rx_head = 0;
+        usart1_rx_restart = 1;
+        HAL_UARTEx_ReceiveToIdle_DMA(&huart1, usart1_rx_buf, USART1_RX_BUF_SIZE);
+    }
+}
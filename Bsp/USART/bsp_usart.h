@@ -0,0 +1,26 @@
+#ifndef __BSP_USART_H
+#define __BSP_USART_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "main.h"
+#include "stdint.h"
+
+#define USART1_RX_BUF_SIZE 256 // 环形DMA接收缓冲区大小
+
+    extern UART_HandleTypeDef huart1;
+
+    // 启动USART1循环DMA接收，配合空闲中断
+    void USART1_RxStart(void);
+
+    // 取出自上次调用以来收到的数据，返回字节数
+    uint16_t USART1_RxRead(uint8_t *data, uint16_t max_len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __BSP_USART_H */
@@ -56,7 +56,7 @@
 #define CMSIS_device_header "stm32f4xx.h"
 #endif /* CMSIS_device_header */
 
-#define configENABLE_FPU                         0
+#define configENABLE_FPU                         1
 #define configENABLE_MPU                         0
 
 #define configUSE_PREEMPTION                     1
@@ -71,6 +71,7 @@
 #define configTOTAL_HEAP_SIZE                    ((size_t)15360)
 #define configMAX_TASK_NAME_LEN                  ( 16 )
 #define configUSE_TRACE_FACILITY                 1
+#define configGENERATE_RUN_TIME_STATS            1
 #define configUSE_16_BIT_TICKS                   0
 #define configUSE_MUTEXES                        1
 #define configQUEUE_REGISTRY_SIZE                8
@@ -163,8 +164,25 @@ standard names. */
 
 #define USE_CUSTOM_SYSTICK_HANDLER_IMPLEMENTATION 0
 
+/* USER CODE BEGIN 2 */
+/* Definitions needed when configGENERATE_RUN_TIME_STATS is on */
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS configureTimerForRunTimeStats
+#define portGET_RUN_TIME_COUNTER_VALUE getRunTimeCounterValue
+/* USER CODE END 2 */
+
 /* USER CODE BEGIN Defines */
 /* Section where parameter definitions can be added (for instance, to override default ones in FreeRTOS.h) */
+/* 跟踪钩子：任务切换与队列操作写入 Module/PROF/ecg_trace.c 的跟踪环 */
+#if defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__)
+#include "ecg_trace.h"
+#if ECG_PROF_ENABLE
+#define traceTASK_SWITCHED_IN() TRACE_Record(TRACE_EV_SWITCH, (uint16_t)pxCurrentTCB->uxTCBNumber)
+#define traceQUEUE_SEND(pxQueue) TRACE_Record(TRACE_EV_QUEUE_SEND, (uint16_t)(uint32_t)(pxQueue))
+#define traceQUEUE_SEND_FROM_ISR(pxQueue) TRACE_Record(TRACE_EV_QUEUE_SEND, (uint16_t)(uint32_t)(pxQueue))
+#define traceQUEUE_RECEIVE(pxQueue) TRACE_Record(TRACE_EV_QUEUE_RECV, (uint16_t)(uint32_t)(pxQueue))
+#define traceQUEUE_RECEIVE_FROM_ISR(pxQueue) TRACE_Record(TRACE_EV_QUEUE_RECV, (uint16_t)(uint32_t)(pxQueue))
+#endif
+#endif
 /* USER CODE END Defines */
 
 #endif /* FREERTOS_CONFIG_H */
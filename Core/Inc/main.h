@@ -41,6 +41,7 @@ extern "C" {
 
 /* Exported constants --------------------------------------------------------*/
 /* USER CODE BEGIN EC */
+#define ECG_FLAG_DRDY 0x0001U // DRDY中断唤醒ECG任务的线程标志
 
 /* USER CODE END EC */
 
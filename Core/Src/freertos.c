@@ -25,10 +25,11 @@
 
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
-
+#include "ecg_mem.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
+typedef StaticTask_t osStaticThreadDef_t;
 /* USER CODE BEGIN PTD */
 
 /* USER CODE END PTD */
@@ -45,20 +46,33 @@
 
 /* Private variables ---------------------------------------------------------*/
 /* USER CODE BEGIN Variables */
+#define RUNTIME_SHIFT 6 // 运行时间计数 = 64位CYCCNT >> 6，168MHz下约27分钟回绕一次
 
+static uint32_t runtime_high; // CYCCNT溢出次数
+static uint32_t runtime_last;
 /* USER CODE END Variables */
 /* Definitions for defaultTask */
 osThreadId_t defaultTaskHandle;
+uint32_t defaultTaskBuffer[ 128 ];
+osStaticThreadDef_t defaultTaskControlBlock;
 const osThreadAttr_t defaultTask_attributes = {
   .name = "defaultTask",
-  .stack_size = 128 * 4,
+  .cb_mem = &defaultTaskControlBlock,
+  .cb_size = sizeof(defaultTaskControlBlock),
+  .stack_mem = &defaultTaskBuffer[0],
+  .stack_size = sizeof(defaultTaskBuffer),
   .priority = (osPriority_t) osPriorityNormal,
 };
 /* Definitions for ECG */
 osThreadId_t ECGHandle;
+uint32_t ECGBuffer[ 1024 ];
+osStaticThreadDef_t ECGControlBlock;
 const osThreadAttr_t ECG_attributes = {
   .name = "ECG",
-  .stack_size = 1024 * 4,
+  .cb_mem = &ECGControlBlock,
+  .cb_size = sizeof(ECGControlBlock),
+  .stack_mem = &ECGBuffer[0],
+  .stack_size = sizeof(ECGBuffer),
   .priority = (osPriority_t) osPriorityNormal,
 };
 
@@ -72,6 +86,36 @@ void ECGTask(void *argument);
 
 void MX_FREERTOS_Init(void); /* (MISRA C 2004 rule 8.1) */
 
+/* Hook prototypes */
+void configureTimerForRunTimeStats(void);
+unsigned long getRunTimeCounterValue(void);
+
+/* USER CODE BEGIN 1 */
+/* Functions needed when configGENERATE_RUN_TIME_STATS is on */
+/**
+ * @brief 运行时间统计以DWT CYCCNT为时基，DWT已在main中初始化
+ */
+void configureTimerForRunTimeStats(void)
+{
+  runtime_high = 0;
+  runtime_last = DWT->CYCCNT;
+}
+
+/**
+ * @brief 将CYCCNT扩展为64位后右移，使32位计数不会在几十秒内回绕
+ * @note 每次任务切换都会调用，两次调用间隔远小于CYCCNT溢出周期
+ */
+unsigned long getRunTimeCounterValue(void)
+{
+  uint32_t now = DWT->CYCCNT;
+
+  if (now < runtime_last)
+    runtime_high++;
+  runtime_last = now;
+  return (unsigned long)((((uint64_t)runtime_high << 32) | now) >> RUNTIME_SHIFT);
+}
+/* USER CODE END 1 */
+
 /**
   * @brief  FreeRTOS initialization
   * @param  None
@@ -128,7 +172,8 @@ void StartDefaultTask(void *argument)
   /* Infinite loop */
   for (;;)
   {
-    osDelay(1);
+    MEM_Sample();
+    osDelay(MEM_SAMPLE_PERIOD_MS);
   }
   /* USER CODE END StartDefaultTask */
 }
@@ -33,6 +33,8 @@
 #include "lcd.h"
 #include "ads1292r.h"
 #include "bsp_dwt.h"
+#include "ecg_cmd.h"
+#include "ecg_prof.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -58,6 +60,8 @@ HAL_StatusTypeDef status;
 /* USER CODE BEGIN PV */
 uint8_t key_mode = 0; // 按键切换模式
 uint8_t ads1292_flag = 0;
+uint32_t ads1292_drdy_stamp = 0; // DRDY中断时刻，用于端到端延迟统计
+extern osThreadId_t ECGHandle;
 /* USER CODE END PV */
 
 /* Private function prototypes -----------------------------------------------*/
@@ -199,10 +203,19 @@ void SystemClock_Config(void)
 /* USER CODE BEGIN 4 */
 void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
 {
+  uint32_t stamp = PROF_Now(); // 入口处取时间戳
+
   if (GPIO_Pin == ADS1292R_DRDY_Pin)
   {
     if (ads1292_flag == 0)
+    {
+      ads1292_drdy_stamp = stamp;
       ads1292_flag = 1;
+      if (ECGHandle != NULL)
+        osThreadFlagsSet(ECGHandle, ECG_FLAG_DRDY);
+    }
+    else
+      ecg_counter.drdy_overrun++;
   }
   else if (GPIO_Pin == KEY_0_Pin)
   {
@@ -22,6 +22,7 @@
 #include "stm32f4xx_it.h"
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
+#include "ecg_trace.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -172,11 +173,11 @@ void DebugMon_Handler(void)
 void EXTI0_IRQHandler(void)
 {
   /* USER CODE BEGIN EXTI0_IRQn 0 */
-
+  TRACE_ISR_ENTER(EXTI0_IRQn);
   /* USER CODE END EXTI0_IRQn 0 */
   HAL_GPIO_EXTI_IRQHandler(ADS1292R_DRDY_Pin);
   /* USER CODE BEGIN EXTI0_IRQn 1 */
-
+  TRACE_ISR_EXIT(EXTI0_IRQn);
   /* USER CODE END EXTI0_IRQn 1 */
 }
 
@@ -186,11 +187,11 @@ void EXTI0_IRQHandler(void)
 void DMA1_Stream5_IRQHandler(void)
 {
   /* USER CODE BEGIN DMA1_Stream5_IRQn 0 */
-
+  TRACE_ISR_ENTER(DMA1_Stream5_IRQn);
   /* USER CODE END DMA1_Stream5_IRQn 0 */
   HAL_DMA_IRQHandler(&hdma_dac1);
   /* USER CODE BEGIN DMA1_Stream5_IRQn 1 */
-
+  TRACE_ISR_EXIT(DMA1_Stream5_IRQn);
   /* USER CODE END DMA1_Stream5_IRQn 1 */
 }
 
@@ -214,11 +215,11 @@ void TIM1_UP_TIM10_IRQHandler(void)
 void USART1_IRQHandler(void)
 {
   /* USER CODE BEGIN USART1_IRQn 0 */
-
+  TRACE_ISR_ENTER(USART1_IRQn);
   /* USER CODE END USART1_IRQn 0 */
   HAL_UART_IRQHandler(&huart1);
   /* USER CODE BEGIN USART1_IRQn 1 */
-
+  TRACE_ISR_EXIT(USART1_IRQn);
   /* USER CODE END USART1_IRQn 1 */
 }
 
@@ -228,11 +229,11 @@ void USART1_IRQHandler(void)
 void SPI3_IRQHandler(void)
 {
   /* USER CODE BEGIN SPI3_IRQn 0 */
-
+  TRACE_ISR_ENTER(SPI3_IRQn);
   /* USER CODE END SPI3_IRQn 0 */
   HAL_SPI_IRQHandler(&hspi3);
   /* USER CODE BEGIN SPI3_IRQn 1 */
-
+  TRACE_ISR_EXIT(SPI3_IRQn);
   /* USER CODE END SPI3_IRQn 1 */
 }
 
@@ -242,11 +243,11 @@ void SPI3_IRQHandler(void)
 void DMA2_Stream0_IRQHandler(void)
 {
   /* USER CODE BEGIN DMA2_Stream0_IRQn 0 */
-
+  TRACE_ISR_ENTER(DMA2_Stream0_IRQn);
   /* USER CODE END DMA2_Stream0_IRQn 0 */
   HAL_DMA_IRQHandler(&hdma_adc1);
   /* USER CODE BEGIN DMA2_Stream0_IRQn 1 */
-
+  TRACE_ISR_EXIT(DMA2_Stream0_IRQn);
   /* USER CODE END DMA2_Stream0_IRQn 1 */
 }
 
@@ -256,11 +257,11 @@ void DMA2_Stream0_IRQHandler(void)
 void DMA2_Stream2_IRQHandler(void)
 {
   /* USER CODE BEGIN DMA2_Stream2_IRQn 0 */
-
+  TRACE_ISR_ENTER(DMA2_Stream2_IRQn);
   /* USER CODE END DMA2_Stream2_IRQn 0 */
   HAL_DMA_IRQHandler(&hdma_usart1_rx);
   /* USER CODE BEGIN DMA2_Stream2_IRQn 1 */
-
+  TRACE_ISR_EXIT(DMA2_Stream2_IRQn);
   /* USER CODE END DMA2_Stream2_IRQn 1 */
 }
 
@@ -270,11 +271,11 @@ void DMA2_Stream2_IRQHandler(void)
 void DMA2_Stream7_IRQHandler(void)
 {
   /* USER CODE BEGIN DMA2_Stream7_IRQn 0 */
-
+  TRACE_ISR_ENTER(DMA2_Stream7_IRQn);
   /* USER CODE END DMA2_Stream7_IRQn 0 */
   HAL_DMA_IRQHandler(&hdma_usart1_tx);
   /* USER CODE BEGIN DMA2_Stream7_IRQn 1 */
-
+  TRACE_ISR_EXIT(DMA2_Stream7_IRQn);
   /* USER CODE END DMA2_Stream7_IRQn 1 */
 }
 
@@ -0,0 +1,76 @@
+#include "ecg_port_host.h"
+#include "ecg_prof.h"
+#include "ads1292r_frame.h"
+#include <string.h>
+
+static ECG_HostPort_t host;
+
+static uint8_t host_read_frame(uint8_t *raw, uint32_t *stamp)
+{
+    if (host.frame_pos >= host.frame_num)
+        return 0;
+    memcpy(raw, host.frames + (size_t)host.frame_pos * ADS1292R_FRAME_SIZE, ADS1292R_FRAME_SIZE);
+    host.frame_pos++;
+    *stamp = PROF_Now();
+    return 1;
+}
+
+static void host_draw_ecg(int32_t y)
+{
+    host.ecg_points++;
+    host.ecg_last = y;
+}
+
+static void host_draw_spectrum(const ecg_spec_t *spec, uint16_t columns)
+{
+    (void)spec;
+    (void)columns;
+    host.spectrum_frames++;
+}
+
+static void host_show_heart_rate(uint32_t bpm)
+{
+    host.heart_rate = bpm;
+}
+
+static void host_show_peak_to_peak(uint32_t p2p)
+{
+    host.peak_to_peak = p2p;
+}
+
+static void host_telemetry(const char *name, long value)
+{
+    if (host.telemetry != NULL)
+        fprintf(host.telemetry, "{%s}%ld\n", name, value);
+}
+
+static const ECG_Port_t host_port = {
+    .read_frame = host_read_frame,
+    .draw_ecg = host_draw_ecg,
+    .draw_spectrum = host_draw_spectrum,
+    .show_heart_rate = host_show_heart_rate,
+    .show_peak_to_peak = host_show_peak_to_peak,
+    .telemetry = host_telemetry,
+    .now = PROF_Now,
+    .clock_hz = 1000000000u,
+};
+
+/**
+ * @brief 初始化主机端接口
+ * @param frames: 原始帧数据
+ * @param frame_num: 帧数
+ * @param telemetry: 遥测输出文件，可为NULL
+ */
+const ECG_Port_t *ECG_HostPort_Init(const uint8_t *frames, uint32_t frame_num, FILE *telemetry)
+{
+    memset(&host, 0, sizeof(host));
+    host.frames = frames;
+    host.frame_num = frame_num;
+    host.telemetry = telemetry;
+    return &host_port;
+}
+
+ECG_HostPort_t *ECG_HostPort_Get(void)
+{
+    return &host;
+}
@@ -0,0 +1,34 @@
+#ifndef ECG_PORT_HOST_H
+#define ECG_PORT_HOST_H
+
+#include "stdint.h"
+#include <stdio.h>
+#include "ecg_port.h"
+
+/*
+ * 信号处理核心的主机端接口
+ *   采样源：内存中连续存放的原始帧，读完即停
+ *   显示：只记录最近一次的值与调用次数
+ *   遥测：写入指定文件，为NULL时丢弃
+ *   时钟：clock_gettime，单位ns
+ */
+
+typedef struct
+{
+    const uint8_t *frames; // 原始帧，每帧 ADS1292R_FRAME_SIZE 字节
+    uint32_t frame_num;
+    uint32_t frame_pos;    // 下一帧序号
+    FILE *telemetry;       // 遥测输出
+
+    /* 显示记录 */
+    uint32_t ecg_points;
+    int32_t ecg_last;
+    uint32_t spectrum_frames;
+    uint32_t heart_rate;
+    uint32_t peak_to_peak;
+} ECG_HostPort_t;
+
+const ECG_Port_t *ECG_HostPort_Init(const uint8_t *frames, uint32_t frame_num, FILE *telemetry); // 初始化并返回接口
+ECG_HostPort_t *ECG_HostPort_Get(void);                                                           // 读取显示记录等状态
+
+#endif // !ECG_PORT_HOST_H
@@ -134,4 +134,35 @@ void ADS1292R_ReadData(uint8_t *data)
         ;
     }
     ADS1292R_CS_H;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief 运行时修改采样率，停止连续读取后改写CONFIG1再恢复
+ * @param sps: 125/250/500/1000/2000/4000/8000，命令只开放到 ECG_RATE_MAX，更高速率没有对应的滤波器设计
+ * @return 0:成功 1:不支持的采样率
+ */
+uint8_t ADS1292R_SetSampleRate(uint16_t sps)
+{
+    uint8_t dr = 0;
+
+    while ((125u << dr) != sps) // CONFIG1[2:0]: 000=125SPS ... 110=8kSPS
+    {
+        if (++dr > 6)
+            return 1;
+    }
+
+    ADS1292R_Halt();
+    ADS1292R_REG(ADS1292R_WREG | ADS1292R_CONFIG1, dr);
+    ADS1292R_Work();
+    return 0;
+}
+
+/**
+ * @brief 运行时写寄存器，写之前退出连续读取模式
+ */
+void ADS1292R_WriteReg(uint8_t addr, uint8_t value)
+{
+    ADS1292R_Halt();
+    ADS1292R_REG(ADS1292R_WREG | addr, value);
+    ADS1292R_Work();
+}
@@ -49,5 +49,7 @@ void ADS1292R_PowerOnInit(void);                 // ADS1292R上电复位
 void ADS1292R_Work(void);                        // ADS1292R连续工作
 void ADS1292R_Halt(void);                        // ADS1292R停止工作
 void ADS1292R_ReadData(uint8_t *data);           // 读取72位的数据
+uint8_t ADS1292R_SetSampleRate(uint16_t sps);    // 运行时修改采样率
+void ADS1292R_WriteReg(uint8_t addr, uint8_t value); // 运行时写寄存器
 
 #endif
\ No newline at end of file
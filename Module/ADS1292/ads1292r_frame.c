@@ -0,0 +1,79 @@
+#include "ads1292r_frame.h"
+#include "ecg_conf.h"
+#include <string.h>
+
+#ifdef ARM_MATH_CM4
+#include "arm_math.h"
+#define ADS1292R_REV(x) __REV(x)
+#else
+#define ADS1292R_REV(x) __builtin_bswap32(x)
+#endif
+
+/**
+ * @brief 从任意地址读取一个32位字，Cortex-M4上编译为一条非对齐LDR
+ */
+static inline uint32_t ads1292r_load32(const uint8_t *p)
+{
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+/**
+ * @brief 批量解析连续存放的多帧数据，分离为两个通道和状态字
+ * @note  每帧用三次字读取+REV完成大端转换：
+ *        p[0..3] 高24位为状态字，p[2..5] 低24位为CH1，p[5..8] 低24位为CH2，
+ *        不会读出本帧之外的字节，可直接处理DMA缓冲区
+ * @param raw: count*9字节原始数据
+ * @param count: 帧数
+ * @param ch1: CH1输出，符号扩展的24位数据，可为NULL
+ * @param ch2: CH2输出，可为NULL
+ * @param status: 状态字输出，可为NULL
+ */
+ECG_RAMFUNC(UNPACK) void ADS1292R_UnpackFrames(const uint8_t *raw, uint16_t count,
+                                               int32_t *ch1, int32_t *ch2, uint32_t *status)
+{
+    for (uint16_t i = 0; i < count; i++, raw += ADS1292R_FRAME_SIZE)
+    {
+        uint32_t w0 = ADS1292R_REV(ads1292r_load32(raw));     // S0 S1 S2 A0
+        uint32_t w1 = ADS1292R_REV(ads1292r_load32(raw + 2)); // S2 A0 A1 A2
+        uint32_t w2 = ADS1292R_REV(ads1292r_load32(raw + 5)); // A2 B0 B1 B2
+
+        if (status)
+            status[i] = w0 >> 8;
+        if (ch1)
+            ch1[i] = (int32_t)(w1 << 8) >> 8; // 算术右移完成符号扩展
+        if (ch2)
+            ch2[i] = (int32_t)(w2 << 8) >> 8;
+    }
+}
+
+/**
+ * @brief 由状态字和两个通道的数据计算样本标志
+ * @return ADS1292R_FLAG_xxx
+ */
+uint8_t ADS1292R_StatusFlags(uint32_t status, int32_t ch1, int32_t ch2)
+{
+    uint8_t flags = 0;
+
+    if (ADS1292R_STATUS_SYNC(status) != 0x0c)
+        flags |= ADS1292R_FLAG_SYNC_ERR;
+    if (ADS1292R_STATUS_LOFF(status) != 0)
+        flags |= ADS1292R_FLAG_LEAD_OFF;
+    if (ch1 == ADS1292R_FULL_SCALE_POS || ch1 == ADS1292R_FULL_SCALE_NEG)
+        flags |= ADS1292R_FLAG_SAT_CH1;
+    if (ch2 == ADS1292R_FULL_SCALE_POS || ch2 == ADS1292R_FULL_SCALE_NEG)
+        flags |= ADS1292R_FLAG_SAT_CH2;
+    return flags;
+}
+
+/**
+ * @brief 解析一帧ADS1292R数据，保留完整24位精度并提取导联脱落、满幅状态
+ * @param raw: 9字节原始数据
+ * @param sample: 解析结果
+ */
+void ADS1292R_ParseFrame(const uint8_t *raw, ADS1292R_Sample_t *sample)
+{
+    ADS1292R_UnpackFrames(raw, 1, &sample->ch[0], &sample->ch[1], &sample->status);
+    sample->flags = ADS1292R_StatusFlags(sample->status, sample->ch[0], sample->ch[1]);
+}
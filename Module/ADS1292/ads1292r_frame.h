@@ -0,0 +1,41 @@
+#ifndef ADS1292R_FRAME_H
+#define ADS1292R_FRAME_H
+
+#include "stdint.h"
+
+/*
+ * ADS1292R 连续读取模式下的一帧数据，共9字节
+ *   字节0-2: 状态字 1100 + LOFF_STAT[4:0] + GPIO[1:0] + 13个0
+ *   字节3-5: CH1 24位补码
+ *   字节6-8: CH2 24位补码
+ * 本文件不依赖HAL，可在主机端编译
+ */
+
+#define ADS1292R_FRAME_SIZE 9
+#define ADS1292R_FULL_SCALE_POS 0x7fffff  // 正满幅
+#define ADS1292R_FULL_SCALE_NEG (-0x800000) // 负满幅
+
+/* 从状态字中取字段 */
+#define ADS1292R_STATUS_SYNC(status) (((status) >> 20) & 0x0f) // 应为0xC
+#define ADS1292R_STATUS_LOFF(status) (((status) >> 15) & 0x1f) // RLD IN2N IN2P IN1N IN1P
+#define ADS1292R_STATUS_GPIO(status) (((status) >> 13) & 0x03)
+
+/* 样本标志 */
+#define ADS1292R_FLAG_LEAD_OFF (1 << 0) // 有导联脱落(需在LOFF_SENS中使能检测)
+#define ADS1292R_FLAG_SAT_CH1 (1 << 1)  // CH1满幅
+#define ADS1292R_FLAG_SAT_CH2 (1 << 2)  // CH2满幅
+#define ADS1292R_FLAG_SYNC_ERR (1 << 3) // 状态字头不是1100，帧错位
+
+typedef struct
+{
+    int32_t ch[2];   // 符号扩展后的24位数据，范围 -0x800000 ~ 0x7fffff
+    uint32_t status; // 24位状态字
+    uint8_t flags;   // ADS1292R_FLAG_xxx
+} ADS1292R_Sample_t;
+
+void ADS1292R_ParseFrame(const uint8_t *raw, ADS1292R_Sample_t *sample); // 解析一帧数据
+uint8_t ADS1292R_StatusFlags(uint32_t status, int32_t ch1, int32_t ch2);  // 由状态字和数据计算样本标志
+void ADS1292R_UnpackFrames(const uint8_t *raw, uint16_t count,
+                           int32_t *ch1, int32_t *ch2, uint32_t *status); // 批量解析连续的多帧数据
+
+#endif // !ADS1292R_FRAME_H
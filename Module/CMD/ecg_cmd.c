@@ -0,0 +1,418 @@
+#include "ecg_cmd.h"
+#include "ecg_prof.h"
+#include "ecg_latency.h"
+#include "ecg_trace.h"
+#include "ecg_mem.h"
+#include "iir.h"
+#include "lms.h"
+#include "fir_bank.h"
+#include "welch.h"
+#include "goertzel.h"
+#include "hrv.h"
+#include "ecg_core.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+ECG_Config_t ecg_config = {
+    .sample_rate = 500,
+    .filter = FIR_MODE_LEGACY,
+    .detect_filter = FIR_MODE_MINPHASE,
+    .iir = IIR_PRESET_NONE,
+    .mains = ECG_MAINS_OFF,
+    .mains_harmonics = 3,
+    .fft_hop = 10,
+    .welch_window = WELCH_WIN_HANN,
+    .welch_avg = 8,
+    .spec_view = WELCH_VIEW_AMPLITUDE,
+    .decim = 2,
+    .band = {
+        [ECG_BAND_MAINS] = {495, 505}, // 工频残余
+        [ECG_BAND_RESP] = {1, 4},      // 呼吸，0.1~0.4Hz
+        [ECG_BAND_HR] = {8, 30},       // 心率基频，48~180bpm
+    },
+    .hrv_window = HRV_WINDOW_MAX_S,
+    .telemetry = ECG_TLM_RAW | ECG_TLM_FILTERED,
+    .display_mode = ECG_DISPLAY_ALL,
+};
+ECG_Counter_t ecg_counter;
+
+static char cmd_line[ECG_CMD_LINE_MAX];
+static uint8_t cmd_len = 0;
+static uint8_t cmd_overflow = 0; // 当前行超长，丢弃到行尾
+static uint8_t cmd_reg[ECG_CMD_REG_QUEUE][2]; // 待写寄存器的地址与值
+static uint8_t cmd_reg_num = 0;
+static uint8_t cmd_reg_pos = 0; // 下一条待取出的序号
+
+/**
+ * @brief 解析一个无符号整数参数，支持0x前缀
+ * @return 0:成功 1:参数缺失或非法
+ */
+static uint8_t cmd_parse_u32(const char *arg, uint32_t *value)
+{
+    char *end;
+
+    if (arg == NULL)
+        return 1;
+    *value = strtoul(arg, &end, 0);
+    return (end == arg || *end != '\0');
+}
+
+static uint8_t cmd_rate_valid(uint32_t sps)
+{
+    for (uint32_t rate = 125; rate <= ECG_RATE_MAX; rate <<= 1)
+    {
+        if (rate == sps)
+            return 1;
+    }
+    return 0;
+}
+
+static void cmd_upper(char *s)
+{
+    for (; s != NULL && *s; s++)
+        *s = (char)toupper((unsigned char)*s);
+}
+
+/**
+ * @brief 输出当前IIR预设在1Hz/10Hz处的群延迟(百分之一样本)，与FIR的固定群延迟对比
+ *        耗时对比见 PROF 命令的 iir/fir 两项
+ */
+static void cmd_iir_dump(void)
+{
+    IIR_t iir;
+
+    IIR_Init(&iir, ecg_config.iir, ecg_config.sample_rate);
+    printf("IIR preset=%u stages=%u gd1=%ld gd10=%ld fir_gd=%u (x0.01 sample)\n", ecg_config.iir, iir.stages,
+           (long)(IIR_GroupDelay(&iir, 1.0f, ecg_config.sample_rate) * 100.0f),
+           (long)(IIR_GroupDelay(&iir, 10.0f, ecg_config.sample_rate) * 100.0f),
+           FIR_Bank_Find(ecg_config.filter, ecg_config.sample_rate)->delay * 100);
+}
+
+/**
+ * @brief 输出各跟踪频带的范围(0.1Hz)、频点数、块长与功率更新间隔(ms)，功率见 ECG_TLM_BAND 遥测
+ */
+static void cmd_band_dump(void)
+{
+#define CMD_BAND_NAME(id, name) name,
+    static const char *const band_name[ECG_BAND_NUM] = {ECG_BANDS(CMD_BAND_NAME)};
+#undef CMD_BAND_NAME
+    GZ_Band_t band;
+
+    for (uint8_t i = 0; i < ECG_BAND_NUM; i++)
+    {
+        GZ_Init(&band, ecg_config.band[i][0] * 0.1f, ecg_config.band[i][1] * 0.1f, ecg_config.sample_rate);
+        printf("BAND %u %s lo=%u hi=%u bins=%u block_ms=%lu update_ms=%lu\n", i, band_name[i],
+               ecg_config.band[i][0], ecg_config.band[i][1], band.bins,
+               (unsigned long)(GZ_BlockSamples(&band) * 1000u / ecg_config.sample_rate),
+               (unsigned long)(GZ_UpdateSamples(&band) * 1000u / ecg_config.sample_rate));
+    }
+}
+
+/**
+ * @brief 输出心率变异性：窗口内NN数、时域指标(0.1ms/0.1%)与最近一张谱的LF/HF(ms²)
+ */
+static void cmd_hrv_dump(void)
+{
+    const HRV_t *hrv = ECG_Core_Hrv();
+    HRV_Time_t tm;
+
+    HRV_GetTime(hrv, &tm);
+    printf("HRV window=%u nn=%u rejected=%lu mean=%ld sdnn=%ld rmssd=%ld pnn50=%ld lf=%ld hf=%ld spectra=%lu\n",
+           ecg_config.hrv_window, tm.beats, (unsigned long)hrv->rejected, (long)(tm.mean_rr * 10.0f),
+           (long)(tm.sdnn * 10.0f), (long)(tm.rmssd * 10.0f), (long)(tm.pnn50 * 10.0f), (long)hrv->lf,
+           (long)hrv->hf, (unsigned long)hrv->spectra);
+}
+
+/**
+ * @brief 执行一行命令
+ * @return 需要应用的更改掩码
+ */
+static uint8_t cmd_execute(char *line)
+{
+    char *name = strtok(line, " \t");
+    char *arg1 = strtok(NULL, " \t");
+    char *arg2 = strtok(NULL, " \t");
+    char *arg3 = strtok(NULL, " \t");
+    const char *err = NULL;
+    uint8_t apply = 0;
+    uint32_t v1 = 0, v2 = 0, v3 = 0;
+
+    if (name == NULL) // 空行
+        return 0;
+    cmd_upper(name);
+    cmd_upper(arg1); // RST等关键字，数字参数的0x前缀strtoul同样接受大写
+
+    if (strcmp(name, "RATE") == 0)
+    {
+        if (cmd_parse_u32(arg1, &v1) || !cmd_rate_valid(v1))
+            err = "rate";
+        else
+        {
+            ecg_config.sample_rate = (uint16_t)v1;
+            apply |= ECG_APPLY_RATE;
+        }
+    }
+    else if (strcmp(name, "FILTER") == 0)
+    {
+        if (arg1 == NULL)
+            FIR_Bank_Dump();
+        else if (cmd_parse_u32(arg1, &v1) || v1 >= FIR_MODE_NUM)
+            err = "filter";
+        else
+            ecg_config.filter = (uint8_t)v1;
+    }
+    else if (strcmp(name, "DETECT") == 0)
+    {
+        if (cmd_parse_u32(arg1, &v1) || v1 >= FIR_MODE_NUM)
+            err = "detect";
+        else
+            ecg_config.detect_filter = (uint8_t)v1;
+    }
+    else if (strcmp(name, "IIR") == 0)
+    {
+        if (arg1 == NULL)
+            cmd_iir_dump();
+        else if (cmd_parse_u32(arg1, &v1) || v1 >= IIR_PRESET_COUNT)
+            err = "iir";
+        else
+            ecg_config.iir = (uint8_t)v1;
+    }
+    else if (strcmp(name, "MAINS") == 0)
+    {
+        if (cmd_parse_u32(arg1, &v1) || (v1 != ECG_MAINS_OFF && v1 != 50 && v1 != 60))
+            err = "mains";
+        else if (arg2 != NULL && (cmd_parse_u32(arg2, &v2) || v2 < 1 || v2 > LMS_MAX_HARMONICS))
+            err = "harmonics";
+        else
+        {
+            ecg_config.mains = (uint8_t)v1;
+            if (arg2 != NULL)
+                ecg_config.mains_harmonics = (uint8_t)v2;
+        }
+    }
+    else if (strcmp(name, "HOP") == 0)
+    {
+        if (cmd_parse_u32(arg1, &v1) || v1 == 0 || v1 > 0xffff)
+            err = "hop";
+        else
+            ecg_config.fft_hop = (uint16_t)v1;
+    }
+    else if (strcmp(name, "WELCH") == 0)
+    {
+        if (cmd_parse_u32(arg1, &v1) || v1 >= WELCH_WIN_NUM)
+            err = "window";
+        else if (arg2 != NULL && (cmd_parse_u32(arg2, &v2) || v2 < 1 || v2 > 0xff))
+            err = "avg";
+        else
+        {
+            ecg_config.welch_window = (uint8_t)v1;
+            if (arg2 != NULL)
+                ecg_config.welch_avg = (uint8_t)v2;
+        }
+    }
+    else if (strcmp(name, "SPEC") == 0)
+    {
+        if (cmd_parse_u32(arg1, &v1) || v1 >= WELCH_VIEW_NUM)
+            err = "spec";
+        else
+            ecg_config.spec_view = (uint8_t)v1;
+    }
+    else if (strcmp(name, "BAND") == 0)
+    {
+        if (arg1 == NULL)
+            cmd_band_dump();
+        else if (cmd_parse_u32(arg1, &v1) || v1 >= ECG_BAND_NUM)
+            err = "band";
+        else if (cmd_parse_u32(arg2, &v2) || cmd_parse_u32(arg3, &v3) || v2 > v3 || v3 * 2u >= ecg_config.sample_rate * 10u)
+            err = "range";
+        else
+        {
+            ecg_config.band[v1][0] = (uint16_t)v2;
+            ecg_config.band[v1][1] = (uint16_t)v3;
+        }
+    }
+    else if (strcmp(name, "HRV") == 0)
+    {
+        if (arg1 == NULL)
+            cmd_hrv_dump();
+        else if (cmd_parse_u32(arg1, &v1) || v1 < HRV_SPECTRUM_MIN_S || v1 > HRV_WINDOW_MAX_S)
+            err = "hrv";
+        else
+            ecg_config.hrv_window = (uint16_t)v1;
+    }
+    else if (strcmp(name, "DECIM") == 0)
+    {
+        if (cmd_parse_u32(arg1, &v1) || (v1 != 1 && v1 != 2 && v1 != 4))
+            err = "decim";
+        else
+            ecg_config.decim = (uint8_t)v1;
+    }
+    else if (strcmp(name, "TLM") == 0)
+    {
+        if (cmd_parse_u32(arg1, &v1) || v1 > 0xffff)
+            err = "tlm";
+        else
+            ecg_config.telemetry = (uint16_t)v1;
+    }
+    else if (strcmp(name, "MODE") == 0)
+    {
+        if (cmd_parse_u32(arg1, &v1) || v1 > ECG_DISPLAY_OFF)
+            err = "mode";
+        else
+            ecg_config.display_mode = (uint8_t)v1;
+    }
+    else if (strcmp(name, "REG") == 0)
+    {
+        if (cmd_parse_u32(arg1, &v1) || cmd_parse_u32(arg2, &v2) || v1 < 0x01 || v1 > 0x0b || v2 > 0xff)
+            err = "reg";
+        else if (v1 == 0x01) // CONFIG1含数据率，直接写会使信号链的采样率与芯片不一致
+            err = "reg 0x01, use RATE";
+        else if (cmd_reg_num >= ECG_CMD_REG_QUEUE)
+            err = "busy";
+        else
+        {
+            cmd_reg[cmd_reg_num][0] = (uint8_t)v1;
+            cmd_reg[cmd_reg_num][1] = (uint8_t)v2;
+            cmd_reg_num++;
+            apply |= ECG_APPLY_REG;
+        }
+    }
+    else if (strcmp(name, "CFG") == 0)
+    {
+        printf("CFG rate=%u filter=%u detect=%u iir=%u mains=%u/%u hop=%u welch=%u/%u spec=%u decim=%u hrv=%u tlm=0x%03x mode=%u\n",
+               ecg_config.sample_rate, ecg_config.filter, ecg_config.detect_filter, ecg_config.iir,
+               ecg_config.mains, ecg_config.mains_harmonics, ecg_config.fft_hop, ecg_config.welch_window,
+               ecg_config.welch_avg, ecg_config.spec_view, ecg_config.decim, ecg_config.hrv_window,
+               ecg_config.telemetry, ecg_config.display_mode);
+    }
+    else if (strcmp(name, "CNT") == 0)
+    {
+        if (arg1 != NULL && strcmp(arg1, "RST") == 0)
+            memset(&ecg_counter, 0, sizeof(ecg_counter));
+        else
+            printf("CNT samples=%lu overrun=%lu fft=%lu cmd_ok=%lu cmd_err=%lu loff=%lu sat=%lu sync=%lu beats=%lu\n",
+                   (unsigned long)ecg_counter.samples, (unsigned long)ecg_counter.drdy_overrun,
+                   (unsigned long)ecg_counter.fft_frames, (unsigned long)ecg_counter.cmd_ok,
+                   (unsigned long)ecg_counter.cmd_err, (unsigned long)ecg_counter.lead_off,
+                   (unsigned long)ecg_counter.saturated, (unsigned long)ecg_counter.sync_err,
+                   (unsigned long)ecg_counter.beats);
+    }
+    else if (strcmp(name, "PROF") == 0)
+    {
+        if (arg1 != NULL && strcmp(arg1, "RST") == 0)
+            PROF_Reset();
+        else
+            PROF_Dump();
+    }
+    else if (strcmp(name, "LAT") == 0)
+    {
+        if (arg1 != NULL && strcmp(arg1, "RST") == 0)
+            LAT_Reset();
+        else
+            LAT_Dump();
+    }
+    else if (strcmp(name, "TRACE") == 0)
+    {
+        if (arg1 != NULL && strcmp(arg1, "RST") == 0)
+            TRACE_Reset();
+        else
+            TRACE_Dump();
+    }
+    else if (strcmp(name, "TASKS") == 0)
+    {
+        TRACE_TaskDump();
+    }
+    else if (strcmp(name, "MEM") == 0)
+    {
+        MEM_Dump();
+    }
+    else if (strcmp(name, "BENCH") == 0)
+    {
+        if (arg1 != NULL && (cmd_parse_u32(arg1, &v1) || v1 == 0 || v1 > 100000))
+            err = "bench";
+        else
+        {
+            uint32_t samples = arg1 != NULL ? v1 : ECG_BENCH_DEFAULT;
+            uint32_t ticks = ECG_Core_Bench(samples);
+
+            printf("BENCH samples=%lu ticks=%lu per_sample=%lu\n", (unsigned long)samples, (unsigned long)ticks,
+                   (unsigned long)(ticks / samples));
+            PROF_Dump();
+        }
+    }
+    else
+    {
+        err = "unknown";
+    }
+
+    if (err != NULL)
+    {
+        ecg_counter.cmd_err++;
+        printf("ERR %s\n", err);
+        return 0;
+    }
+    ecg_counter.cmd_ok++;
+    printf("OK\n");
+    return apply;
+}
+
+/**
+ * @brief 输入串口收到的字节流，按行拼接并执行命令
+ * @param data: 收到的数据
+ * @param len: 数据长度
+ * @return 需要任务应用到硬件的更改掩码 ECG_APPLY_xxx
+ */
+uint8_t ECG_Cmd_Input(const uint8_t *data, uint16_t len)
+{
+    uint8_t apply = 0;
+
+    for (uint16_t i = 0; i < len; i++)
+    {
+        char c = (char)data[i];
+
+        if (c == '\n' || c == '\r')
+        {
+            if (cmd_overflow)
+            {
+                ecg_counter.cmd_err++;
+                printf("ERR length\n");
+            }
+            else if (cmd_len > 0)
+            {
+                cmd_line[cmd_len] = '\0';
+                apply |= cmd_execute(cmd_line);
+            }
+            cmd_len = 0;
+            cmd_overflow = 0;
+        }
+        else if (cmd_len < ECG_CMD_LINE_MAX - 1)
+        {
+            cmd_line[cmd_len++] = c;
+        }
+        else
+        {
+            cmd_overflow = 1;
+        }
+    }
+    return apply;
+}
+
+/**
+ * @brief 取出一条待写寄存器，任务在 ECG_Cmd_Input 返回 ECG_APPLY_REG 后循环调用直到返回0
+ * @return 1:取出一条 0:队列已空
+ */
+uint8_t ECG_Cmd_RegPop(uint8_t *addr, uint8_t *value)
+{
+    if (cmd_reg_pos >= cmd_reg_num)
+    {
+        cmd_reg_num = 0;
+        cmd_reg_pos = 0;
+        return 0;
+    }
+    *addr = cmd_reg[cmd_reg_pos][0];
+    *value = cmd_reg[cmd_reg_pos][1];
+    cmd_reg_pos++;
+    return 1;
+}
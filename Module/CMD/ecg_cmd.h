@@ -0,0 +1,120 @@
+#ifndef ECG_CMD_H
+#define ECG_CMD_H
+
+#include "stdint.h"
+
+/*
+ * 串口命令协议：一行一条命令，'\n' 或 '\r' 结尾，命令字不区分大小写
+ *   RATE <sps>       设置ADS1292R采样率 125/250/500/1000
+ *   FILTER [n]       选择显示支路的滤波器组设计 0:原设计 1:直通 2:监护 3:诊断 4:低延迟 5:最小相位，
+ *                    不带参数时列出所有设计
+ *   DETECT <n>       选择R峰检测支路的滤波器组设计，取值同FILTER
+ *   IIR [n]          选择陷波/高通预设，见 IIR_PRESET_xxx；不带参数时回读与FIR的群延迟对比
+ *   MAINS <f> [n]    工频干扰自适应抵消 0:关闭 50/60:工频，n为抵消的谐波数(含基波)1~3
+ *   HOP <n>          每n个抽取后样本做一次FFT，即Welch分段间隔，重叠率为1-n/1024
+ *   WELCH <w> [n]    功率谱窗函数 0:矩形 1:Hann 2:Blackman，n为指数平均的时间常数(分段数)1~255
+ *   SPEC <n>         频谱显示刻度 0:功率 1:幅值 2:dB
+ *   BAND [n lo hi]   设置第n个跟踪频带的范围，单位0.1Hz，n见 ECG_BANDS；不带参数时列出各频带
+ *   HRV [s]          设置心率变异性的窗口长度(秒，最长300)；不带参数时回读时域与频域指标
+ *   DECIM <n>        频谱支路抽取倍数 1/2/4
+ *   TLM <mask>       遥测内容掩码，见 ECG_TLM_xxx，支持0x前缀
+ *   MODE <n>         显示模式 0:波形+频谱 1:仅波形 2:关闭屏幕刷新
+ *   REG <addr> <val> 直接写ADS1292R寄存器，地址0x02~0x0b(0x00为只读的ID，0x01含数据率，用RATE设置)，
+ *                    同一批数据中的多条按顺序写入
+ *   CFG              回读当前配置
+ *   CNT [RST]        回读/清零计数器，参数同样不区分大小写
+ *   PROF [RST]       回读/清零各阶段耗时统计
+ *   LAT [RST]        回读/清零DRDY到滤波/遥测/显示的延迟统计，以及显示/检测支路的信号延迟
+ *   TRACE [RST]      导出/清空任务切换、中断与队列事件跟踪环
+ *   TASKS            回读各任务自上次查询以来的CPU占用率(千分比)
+ *   MEM              回读栈、堆、DSP缓冲区与静态RAM的内存预算
+ *   BENCH [n]        用n个(默认5000)合成样本驱动信号链，输出每样本总时钟数与各阶段统计，
+ *                    期间ADS1292R的数据被丢弃，用于对比 DSP_CCM/RAMFUNC/PROFILE 等构建选项
+ * 应答为 "OK"、"ERR <原因>" 或对应的数据行
+ */
+
+#define ECG_CMD_LINE_MAX 64 // 单行命令最大长度
+#define ECG_CMD_REG_QUEUE 8 // 等待任务写入的REG命令数
+#define ECG_BENCH_DEFAULT 5000 // BENCH命令默认的样本数
+#define ECG_RATE_MAX 1000   // 滤波器组设计与QRS积分窗只覆盖到1000SPS，芯片支持的2k~8kSPS不开放
+
+/* 遥测内容掩码 */
+#define ECG_TLM_RAW (1 << 0)      // CH1原始数据
+#define ECG_TLM_FILTERED (1 << 1) // 滤波后数据
+#define ECG_TLM_CH2 (1 << 2)      // CH2原始数据
+#define ECG_TLM_FREQ (1 << 3)     // FFT计算得到的频率
+#define ECG_TLM_STATUS (1 << 4)   // 导联脱落/满幅标志
+#define ECG_TLM_QRS (1 << 5)      // R峰时刻、RR间期与心率
+#define ECG_TLM_MEM (1 << 6)      // 最小栈余量与堆最小剩余，每秒一次
+#define ECG_TLM_MAINS (1 << 7)    // 工频干扰幅值与跟踪到的工频，每秒一次
+#define ECG_TLM_BAND (1 << 8)     // 各跟踪频带的RMS，每块一次
+#define ECG_TLM_HRV (1 << 9)      // 心率变异性指标，每完成一张LF/HF谱一次
+#define ECG_TLM_STATS (1 << 10)   // 窗口内峰峰值、均值与标准差，随频率一起输出
+
+/* 工频干扰抵消 */
+#define ECG_MAINS_OFF 0
+
+/* 跟踪功率的频带，供信号质量与报警判断使用，功率至少每 GZ_MAX_BLOCK_S 更新一次 */
+#define ECG_BANDS(X)  \
+    X(MAINS, "mains") \
+    X(RESP, "resp")   \
+    X(HR, "hr")
+
+#define ECG_BAND_ID(id, name) ECG_BAND_##id,
+enum
+{
+    ECG_BANDS(ECG_BAND_ID)
+    ECG_BAND_NUM
+};
+#undef ECG_BAND_ID
+
+/* 显示模式 */
+#define ECG_DISPLAY_ALL 0
+#define ECG_DISPLAY_ECG 1
+#define ECG_DISPLAY_OFF 2
+
+/* ECG_Cmd_Input 返回的需由任务应用到硬件的更改 */
+#define ECG_APPLY_RATE (1 << 0) // 需要重新设置采样率
+#define ECG_APPLY_REG (1 << 1)  // 有待写的寄存器，用 ECG_Cmd_RegPop 逐个取出
+
+typedef struct
+{
+    uint16_t sample_rate; // 采样率，单位SPS
+    uint8_t filter;       // 显示支路的滤波模式，见 FIR_MODE_xxx
+    uint8_t detect_filter; // 检测支路的滤波模式
+    uint8_t iir;          // IIR预设
+    uint8_t mains;        // 工频，0时关闭LMS抵消
+    uint8_t mains_harmonics; // LMS抵消的谐波数
+    uint16_t fft_hop;     // FFT间隔，单位为抽取后样本
+    uint8_t welch_window; // 功率谱窗函数，见 WELCH_WIN_xxx
+    uint8_t welch_avg;    // 功率谱指数平均的时间常数，单位为分段
+    uint8_t spec_view;    // 频谱显示刻度，见 WELCH_VIEW_xxx
+    uint8_t decim;        // 频谱支路抽取倍数
+    uint16_t band[ECG_BAND_NUM][2]; // 跟踪频带的下限/上限，单位0.1Hz
+    uint16_t hrv_window;  // 心率变异性窗口，单位s
+    uint16_t telemetry;   // 遥测内容掩码
+    uint8_t display_mode; // 显示模式
+} ECG_Config_t;
+
+typedef struct
+{
+    uint32_t samples;      // 已处理样本数
+    uint32_t drdy_overrun; // DRDY到来时上一个样本还未读走
+    uint32_t fft_frames;   // FFT次数
+    uint32_t cmd_ok;       // 执行成功的命令数
+    uint32_t cmd_err;      // 出错的命令数
+    uint32_t lead_off;     // 导联脱落的样本数
+    uint32_t saturated;    // 满幅的样本数
+    uint32_t sync_err;     // 状态字错位的帧数
+    uint32_t beats;        // 检出的心拍数
+} ECG_Counter_t;
+
+extern ECG_Config_t ecg_config;
+extern ECG_Counter_t ecg_counter;
+
+// 输入串口收到的字节流，返回需要应用的更改掩码 ECG_APPLY_xxx
+uint8_t ECG_Cmd_Input(const uint8_t *data, uint16_t len);
+// 按收到的顺序取出一条待写寄存器，返回0表示已取完
+uint8_t ECG_Cmd_RegPop(uint8_t *addr, uint8_t *value);
+
+#endif // !ECG_CMD_H
@@ -0,0 +1,596 @@
+#include "ecg_core.h"
+#include "ecg_cmd.h"
+#include "ecg_prof.h"
+#include "ecg_latency.h"
+#include "ads1292r_frame.h"
+#include "FIR.h"
+#include "fir_decim.h"
+#include "iir.h"
+#include "lms.h"
+#include "qrs.h"
+#include "welch.h"
+#include "goertzel.h"
+#include "wstat.h"
+#include "ecg_synth.h"
+#include <math.h>
+#include <stddef.h>
+#include <string.h>
+
+/*
+ * 采集得到符号扩展的24位int32样本
+ * 定点信号链：左移8位即为Q31，FIR与FFT都直接使用Q31数据
+ * 浮点信号链：FIR直接读入int32样本，输出float供环形缓冲区和FFT使用
+ * 频谱为Welch功率谱密度，两种信号链的输出都是float，单位为 (24位刻度)^2/Hz
+ */
+#if ECG_USE_FIXED_POINT
+#define ECG_FROM_SAMPLE(x) ((int32_t)((uint32_t)(x) << 8))
+#define ECG_TO_DISPLAY(x) ((x) >> 16) // 显示刻度为24位数据的高16位
+#if ECG_FIR_Q15
+#define ECG_FIR(f, x) ((int32_t)((uint32_t)(int32_t)FIR_filter_q15((f), (int16_t)((x) >> 16)) << 16))
+#else
+#define ECG_FIR(f, x) FIR_filter_q31((f), (x))
+#endif
+#define ECG_DECIM(x, y) FIR_Decim_ProcessQ31(&ecg_decim, (x), (y))
+#define ECG_IIR(x) IIR_ProcessQ31(&ecg_iir, (x))
+#define ECG_LMS(x) ((int32_t)((uint32_t)(int32_t)LMS_Process(&ecg_lms, (float)((x) >> 8)) << 8)) // LMS按24位刻度计算
+#define ECG_TO_COUNTS(x) ((x) >> 8) // 24位刻度
+#else
+#define ECG_FROM_SAMPLE(x) ((float)(x))
+#define ECG_TO_DISPLAY(x) ((int32_t)(x) >> 8)
+#define ECG_FIR(f, x) FIR_filter((f), (x))
+#define ECG_DECIM(x, y) FIR_Decim_Process(&ecg_decim, (x), (y))
+#define ECG_IIR(x) IIR_Process(&ecg_iir, (x))
+#define ECG_LMS(x) LMS_Process(&ecg_lms, (x))
+#define ECG_TO_COUNTS(x) ((int32_t)(x))
+#endif
+
+#define FFT_LENGTH ECG_FFT_LENGTH
+#define ECG_AUTOSCALE_MIN_SPAN 4000 // 自动缩放的最小范围，24位刻度，约0.2mV(PGA=6)
+#define ECG_PEAK_MIN_HZ 6.0f        // 频谱峰值只在该频率以上搜索，跳过基线漂移与呼吸
+
+ECG_DSP_BSS static WELCH_t ecg_welch; // 功率谱估计，其环形缓冲区存储抽取后的ECG数据，也用于峰峰值
+static uint8_t ecg_welch_window;      // 当前生效的窗函数
+static uint8_t ecg_welch_avg;         // 当前生效的平均时间常数
+ECG_DSP_BSS static ecg_spec_t ecg_spec_view[FFT_LENGTH / 2]; // 按屏幕列压缩后的显示值
+ECG_DSP_BSS static WSTAT_t ecg_window; // Welch环形缓冲区窗口的最大/最小值、均值与标准差，用于峰峰值与自动缩放
+
+static const ECG_Port_t *ecg_port;
+static ADS1292R_Sample_t ecg_sample; // 解析后的24位样本与状态
+static uint32_t ecg_sample_stamp;    // 当前样本的DRDY时间戳，随样本经过整条流水线
+static uint32_t ecg_sample_ticks;    // 一个采样周期对应的时钟数
+static ecg_data_t FIR_filtered_data = 0; // 显示支路：绘图、遥测与频谱
+static ecg_data_t ecg_detect_data = 0;   // 检测支路：R峰检测，与显示支路并行，延迟更小
+ECG_DSP_BSS static FIR_t ecg_fir; // 显示支路当前选择的滤波器组设计
+static uint8_t ecg_fir_mode;      // 当前生效的滤波模式
+ECG_DSP_BSS static FIR_t ecg_fir_detect; // 检测支路的滤波器
+static uint8_t ecg_detect_mode;
+ECG_DSP_BSS static IIR_t ecg_iir;  // 陷波/高通，位于FIR之前
+static uint8_t ecg_iir_preset;     // 当前生效的预设
+static uint16_t ecg_iir_delay;     // 10Hz处的群延迟，用于R峰时刻补偿
+static LMS_t ecg_lms;              // 工频干扰自适应抵消，位于IIR之后
+static uint8_t ecg_lms_mains;      // 当前生效的工频设置
+static uint8_t ecg_lms_harmonics;
+static uint16_t ecg_lms_report;    // 遥测计数，每秒输出一次干扰幅值
+static GZ_Band_t ecg_band[ECG_BAND_NUM];        // 频带功率跟踪，输入为FIR之前的全速率数据
+static uint16_t ecg_band_range[ECG_BAND_NUM][2]; // 当前生效的频带范围
+ECG_DSP_BSS static FIR_Decim_t ecg_decim; // 频谱支路的抽取器，全速率数据只用于R峰检测和绘图
+ECG_DSP_BSS static QRS_t qrs; // R峰检测
+ECG_DSP_BSS static HRV_t ecg_hrv; // 心率变异性，输入为补偿群延迟后的R峰时刻
+static uint16_t ecg_hrv_window;   // 当前生效的窗口长度
+
+static void ecg_data_process(const uint8_t *raw);
+static void ecg_iir_init(void);
+static void ecg_lms_init(void);
+static void ecg_lms_report_process(void);
+static void ecg_band_init(void);
+static void ecg_band_process(float x);
+static void ecg_qrs_process(void);
+static void ecg_hrv_report(void);
+static void ecg_welch_init(void);
+static uint8_t update_ecg_buffer(ecg_data_t new_ecg_data);
+static int32_t ecg_display_y(ecg_data_t x);
+static void ecg_spectrum_process(void);
+
+#if ECG_PROF_ENABLE
+#define ECG_LAT_MARK(point) LAT_Record(LAT_##point, ecg_port->now() - ecg_sample_stamp)
+#define ECG_LAT_PATH(path, delay) LAT_PathRecord(LAT_PATH_##path, ecg_port->now() - ecg_sample_stamp + (delay))
+#else
+#define ECG_LAT_MARK(point)
+#define ECG_LAT_PATH(path, delay)
+#endif
+
+/**
+ * @brief 初始化信号处理核心
+ * @param port: 硬件接口，需在整个运行期间有效
+ */
+void ECG_Core_Init(const ECG_Port_t *port)
+{
+    ecg_port = port;
+    ecg_fir_mode = ecg_config.filter;
+    ecg_detect_mode = ecg_config.detect_filter;
+    FIR_Init(&ecg_fir, FIR_Bank_Find(ecg_fir_mode, ecg_config.sample_rate));
+    FIR_Init(&ecg_fir_detect, FIR_Bank_Find(ecg_detect_mode, ecg_config.sample_rate));
+    ECG_Core_SetSampleRate(ecg_config.sample_rate);
+}
+
+/**
+ * @brief 采样率改变后重置检测器与截止时间
+ */
+void ECG_Core_SetSampleRate(uint16_t sps)
+{
+    QRS_Init(&qrs, sps);
+    ecg_hrv_window = ecg_config.hrv_window;
+    HRV_Init(&ecg_hrv, ecg_hrv_window); // R峰时刻随QRS检测器从0开始
+    ecg_fir_mode = ecg_config.filter;
+    ecg_detect_mode = ecg_config.detect_filter;
+    FIR_Select(&ecg_fir, FIR_Bank_Find(ecg_fir_mode, sps));
+    FIR_Select(&ecg_fir_detect, FIR_Bank_Find(ecg_detect_mode, sps));
+    ecg_sample_ticks = ecg_port->clock_hz / sps;
+    ecg_iir_init();
+    ecg_lms_init();
+    ecg_band_init();
+    FIR_Decim_Init(&ecg_decim, ecg_config.decim);
+    ecg_welch_init();
+    LAT_SetDeadline(ecg_sample_ticks);
+}
+
+/**
+ * @brief 从采样源读取一帧并处理
+ * @return 1:处理了一帧新数据
+ */
+uint8_t ECG_Core_Poll(void)
+{
+    uint8_t raw[ADS1292R_FRAME_SIZE];
+    uint32_t stamp;
+
+    if (!ecg_port->read_frame(raw, &stamp))
+        return 0;
+    ECG_Core_Process(raw, stamp);
+    return 1;
+}
+
+/**
+ * @brief 处理一帧原始数据：解析、滤波、遥测、R峰检测、绘图，
+ *        抽取后存入环形缓冲区，每fft_hop个抽取后样本更新一次功率谱
+ * @param raw: ADS1292R_FRAME_SIZE 字节的原始帧
+ * @param stamp: DRDY时刻，用于端到端延迟统计
+ */
+void ECG_Core_Process(const uint8_t *raw, uint32_t stamp)
+{
+    ecg_data_t decimated;
+    uint8_t decim_out;
+    uint8_t segment;
+
+    ecg_sample_stamp = stamp;
+    ecg_data_process(raw);
+    ecg_counter.samples++;
+
+    // IIR 陷波/高通，随后 FIR 滤波
+    if (ecg_iir_preset != ecg_config.iir)
+        ecg_iir_init();
+    PROF_BEGIN(IIR);
+    FIR_filtered_data = ECG_IIR(ECG_FROM_SAMPLE(ecg_sample.ch[0]));
+    PROF_END(IIR);
+    if (ecg_lms_mains != ecg_config.mains || ecg_lms_harmonics != ecg_config.mains_harmonics)
+        ecg_lms_init();
+    if (ecg_lms_mains != ECG_MAINS_OFF)
+    {
+        PROF_BEGIN(LMS);
+        FIR_filtered_data = ECG_LMS(FIR_filtered_data);
+        PROF_END(LMS);
+        ecg_lms_report_process();
+    }
+    if (memcmp(ecg_band_range, ecg_config.band, sizeof(ecg_band_range)) != 0)
+        ecg_band_init();
+    PROF_BEGIN(BAND);
+    ecg_band_process((float)ECG_TO_COUNTS(FIR_filtered_data));
+    PROF_END(BAND);
+    // 切换设计只更换系数，输入历史共用，不会产生过渡
+    if (ecg_fir_mode != ecg_config.filter)
+    {
+        ecg_fir_mode = ecg_config.filter;
+        FIR_Select(&ecg_fir, FIR_Bank_Find(ecg_fir_mode, ecg_config.sample_rate));
+    }
+    if (ecg_detect_mode != ecg_config.detect_filter)
+    {
+        ecg_detect_mode = ecg_config.detect_filter;
+        FIR_Select(&ecg_fir_detect, FIR_Bank_Find(ecg_detect_mode, ecg_config.sample_rate));
+    }
+    PROF_BEGIN(FIR);
+    ecg_detect_data = ECG_FIR(&ecg_fir_detect, FIR_filtered_data);
+    FIR_filtered_data = ECG_FIR(&ecg_fir, FIR_filtered_data);
+    PROF_END(FIR);
+    ECG_LAT_MARK(FILTER);
+    if (ecg_config.telemetry & ECG_TLM_FILTERED)
+    {
+        PROF_BEGIN(PRINTF);
+        ecg_port->telemetry("FIR_filtered_data", (long)FIR_filtered_data);
+        PROF_END(PRINTF);
+        ECG_LAT_MARK(TELEMETRY);
+    }
+    ecg_qrs_process();
+    if (ecg_config.display_mode != ECG_DISPLAY_OFF && ecg_port->draw_ecg != NULL)
+    {
+        PROF_BEGIN(DRAW);
+        ecg_port->draw_ecg(ecg_display_y(FIR_filtered_data));
+        PROF_END(DRAW);
+        ECG_LAT_MARK(DISPLAY);
+        // 屏幕上的点对应群延迟之前的输入，加上滤波器延迟即为显示支路的信号延迟
+        ECG_LAT_PATH(DISPLAY, (uint32_t)(FIR_Delay(&ecg_fir) + ecg_iir_delay) * ecg_sample_ticks);
+    }
+
+    // 频谱支路抽取，同样1024点覆盖的时间窗口扩大decim倍
+    if (ecg_decim.factor != ecg_config.decim)
+    {
+        FIR_Decim_Init(&ecg_decim, ecg_config.decim);
+        ecg_welch_init(); // 功率谱的采样率随之改变
+    }
+    PROF_BEGIN(DECIM);
+    decim_out = ECG_DECIM(FIR_filtered_data, &decimated);
+    PROF_END(DECIM);
+    if (!decim_out)
+        return;
+    if (ecg_welch_window != ecg_config.welch_window)
+        ecg_welch_init();
+    if (ecg_welch.hop != ecg_config.fft_hop || ecg_welch_avg != ecg_config.welch_avg)
+    {
+        ecg_welch_avg = ecg_config.welch_avg;
+        WELCH_Config(&ecg_welch, ecg_config.fft_hop, ecg_welch_avg);
+    }
+    PROF_BEGIN(RING);
+    segment = update_ecg_buffer(decimated);
+    PROF_END(RING);
+
+    // 每fft_hop个抽取后样本处理一个分段，重叠率为 1-fft_hop/FFT_LENGTH
+    if (segment)
+    {
+        PROF_BEGIN(FFT);
+        WELCH_Transform(&ecg_welch);
+        PROF_END(FFT);
+        PROF_BEGIN(MAG);
+        WELCH_Accumulate(&ecg_welch);
+        PROF_END(MAG);
+        ecg_counter.fft_frames++;
+        if (ecg_config.display_mode == ECG_DISPLAY_ALL && ecg_port->draw_spectrum != NULL)
+        {
+            uint16_t columns = ecg_port->spectrum_width ? ecg_port->spectrum_width : FFT_LENGTH / 2;
+
+            PROF_BEGIN(MAG);
+            WELCH_View(&ecg_welch, ecg_spec_view, columns, ecg_config.spec_view);
+            PROF_END(MAG);
+            PROF_BEGIN(DRAW);
+            ecg_port->draw_spectrum(ecg_spec_view, columns);
+            PROF_END(DRAW);
+        }
+        ecg_spectrum_process(); // 遥测与显示模式无关
+    }
+}
+
+/**
+ * @brief 没有新帧时调用：推进HRV的频域计算，每次最多 HRV_STEP_POINTS 个心拍，完成一张谱时输出遥测
+ */
+void ECG_Core_Idle(void)
+{
+    uint8_t done;
+
+    PROF_BEGIN(HRV);
+    done = HRV_Step(&ecg_hrv);
+    PROF_END(HRV);
+    if (done)
+        ecg_hrv_report();
+}
+
+/**
+ * @brief 基准：合成ECG逐帧经过整条信号链，各阶段耗时记入PROF，数据与缓冲区都是实际运行时的那一份
+ *        打开高通+50Hz陷波与LMS抵消，关闭显示与遥测，只统计信号处理本身
+ *        结束后恢复配置并重新初始化，期间采样源的数据被丢弃
+ * @param samples: 样本数
+ * @return 总耗时，单位为 ecg_port->now 的时钟
+ */
+uint32_t ECG_Core_Bench(uint32_t samples)
+{
+    const ECG_Port_t *port = ecg_port;
+    static ECG_Port_t bench_port; // 只保留时钟，显示项为NULL
+    ECG_Config_t config = ecg_config;
+    uint8_t raw[ADS1292R_FRAME_SIZE];
+    SYNTH_Param_t param;
+    SYNTH_t synth;
+    uint32_t ticks = 0;
+
+    bench_port = *port;
+    bench_port.draw_ecg = NULL;
+    bench_port.draw_spectrum = NULL;
+    bench_port.show_heart_rate = NULL;
+    bench_port.show_peak_to_peak = NULL;
+    ecg_config.iir = IIR_PRESET_HP_NOTCH50;
+    ecg_config.mains = 50;
+    ecg_config.telemetry = 0;
+    ecg_config.display_mode = ECG_DISPLAY_OFF;
+    ECG_Core_Init(&bench_port);
+
+    SYNTH_BenchParam(&param, ecg_config.sample_rate);
+    SYNTH_Init(&synth, &param);
+
+    PROF_Reset();
+    for (uint32_t i = 0; i < samples; i++)
+    {
+        uint32_t t0;
+
+        SYNTH_Frame(&synth, raw); // 合成不计入耗时
+        t0 = port->now();
+        ECG_Core_Process(raw, t0);
+        ECG_Core_Idle();
+        ticks += port->now() - t0;
+    }
+    LAT_Reset(); // 基准期间的延迟不是实际采样得到的
+
+    ecg_config = config;
+    ECG_Core_Init(port);
+    return ticks;
+}
+
+const HRV_t *ECG_Core_Hrv(void)
+{
+    return &ecg_hrv;
+}
+
+/**
+ * @brief ECG 数据处理，解析单次采集的CH1和CH2数据，保留完整24位精度
+ */
+static void ecg_data_process(const uint8_t *raw)
+{
+    PROF_BEGIN(UNPACK);
+    ADS1292R_ParseFrame(raw, &ecg_sample);
+    PROF_END(UNPACK);
+
+    if (ecg_sample.flags & ADS1292R_FLAG_LEAD_OFF)
+        ecg_counter.lead_off++;
+    if (ecg_sample.flags & (ADS1292R_FLAG_SAT_CH1 | ADS1292R_FLAG_SAT_CH2))
+        ecg_counter.saturated++;
+    if (ecg_sample.flags & ADS1292R_FLAG_SYNC_ERR)
+        ecg_counter.sync_err++;
+
+    // 只统计实际输出的遥测，未开启时不记入空样本
+    if (ecg_config.telemetry & ECG_TLM_RAW)
+    {
+        PROF_BEGIN(PRINTF);
+        ecg_port->telemetry("ecg_channel_1", (long)ecg_sample.ch[0]);
+        PROF_END(PRINTF);
+    }
+    if (ecg_config.telemetry & ECG_TLM_CH2)
+    {
+        PROF_BEGIN(PRINTF);
+        ecg_port->telemetry("ecg_channel_2", (long)ecg_sample.ch[1]);
+        PROF_END(PRINTF);
+    }
+    if (ecg_config.telemetry & ECG_TLM_STATUS)
+    {
+        PROF_BEGIN(PRINTF);
+        ecg_port->telemetry("ecg_status", ecg_sample.flags);
+        PROF_END(PRINTF);
+    }
+}
+
+/**
+ * @brief 按当前预设与采样率设计IIR
+ */
+static void ecg_iir_init(void)
+{
+    ecg_iir_preset = ecg_config.iir;
+    IIR_Init(&ecg_iir, ecg_iir_preset, ecg_config.sample_rate);
+    ecg_iir_delay = (uint16_t)(IIR_GroupDelay(&ecg_iir, 10.0f, ecg_config.sample_rate) + 0.5f);
+}
+
+/**
+ * @brief 按当前工频设置初始化LMS，收敛时间约1000个样本
+ */
+static void ecg_lms_init(void)
+{
+    ecg_lms_mains = ecg_config.mains;
+    ecg_lms_harmonics = ecg_config.mains_harmonics;
+    ecg_lms_report = 0;
+    LMS_Init(&ecg_lms, ecg_lms_mains, ecg_lms_harmonics, ecg_config.sample_rate, 0.001f,
+             200.0f); // 约10uV(PGA=6)
+}
+
+/**
+ * @brief 每秒输出一次干扰幅值(24位刻度)与跟踪到的工频(mHz)，作为信号质量指标
+ */
+static void ecg_lms_report_process(void)
+{
+    if (++ecg_lms_report < ecg_config.sample_rate)
+        return;
+    ecg_lms_report = 0;
+    if (ecg_config.telemetry & ECG_TLM_MAINS)
+    {
+        ecg_port->telemetry("mains_amp", (long)LMS_Amplitude(&ecg_lms));
+        ecg_port->telemetry("mains_freq", (long)(ecg_lms.freq * 1000.0f));
+    }
+}
+
+/**
+ * @brief 输出心率变异性：时域指标单位0.1ms/0.1%，LF/HF单位ms²，比值x100
+ */
+static void ecg_hrv_report(void)
+{
+    HRV_Time_t tm;
+
+    if (!(ecg_config.telemetry & ECG_TLM_HRV))
+        return;
+    HRV_GetTime(&ecg_hrv, &tm);
+    ecg_port->telemetry("hrv_sdnn", (long)(tm.sdnn * 10.0f));
+    ecg_port->telemetry("hrv_rmssd", (long)(tm.rmssd * 10.0f));
+    ecg_port->telemetry("hrv_pnn50", (long)(tm.pnn50 * 10.0f));
+    ecg_port->telemetry("hrv_lf", (long)ecg_hrv.lf);
+    ecg_port->telemetry("hrv_hf", (long)ecg_hrv.hf);
+    ecg_port->telemetry("hrv_lf_hf", ecg_hrv.hf > 0.0f ? (long)(100.0f * ecg_hrv.lf / ecg_hrv.hf) : 0);
+}
+
+/**
+ * @brief 按当前频带设置与采样率初始化频带跟踪
+ */
+static void ecg_band_init(void)
+{
+    memcpy(ecg_band_range, ecg_config.band, sizeof(ecg_band_range));
+    for (uint8_t i = 0; i < ECG_BAND_NUM; i++)
+        GZ_Init(&ecg_band[i], ecg_band_range[i][0] * 0.1f, ecg_band_range[i][1] * 0.1f, ecg_config.sample_rate);
+}
+
+/**
+ * @brief 更新各频带的功率，一块结束时输出带内RMS(24位刻度)
+ *        输入在LMS之后、FIR之前，工频频带反映的是LMS抵消后的残余
+ */
+static void ecg_band_process(float x)
+{
+#define ECG_BAND_TLM(id, name) "band_" name,
+    static const char *const band_tlm[ECG_BAND_NUM] = {ECG_BANDS(ECG_BAND_TLM)};
+#undef ECG_BAND_TLM
+
+    for (uint8_t i = 0; i < ECG_BAND_NUM; i++)
+    {
+        if (GZ_Process(&ecg_band[i], x) && (ecg_config.telemetry & ECG_TLM_BAND))
+            ecg_port->telemetry(band_tlm[i], (long)sqrtf(ecg_band[i].power));
+    }
+}
+
+const WSTAT_t *ECG_Core_Window(void)
+{
+    return &ecg_window;
+}
+
+float ECG_Core_BandPower(uint8_t band)
+{
+    return band < ECG_BAND_NUM ? ecg_band[band].power : 0.0f;
+}
+
+/**
+ * @brief R峰检测，使用检测支路，检出心拍时输出R峰时刻、RR间期和心率
+ */
+static void ecg_qrs_process(void)
+{
+    uint32_t r_sample;
+    uint8_t beat;
+
+    PROF_BEGIN(QRS);
+    beat = QRS_Process(&qrs, (float)ecg_detect_data);
+    PROF_END(QRS);
+    if (!beat)
+        return;
+
+    ecg_counter.beats++;
+    // 检测器输入经过了IIR与检测支路FIR，R峰时刻扣除两者在QRS主频处的群延迟
+    r_sample = qrs.r_sample;
+    if (r_sample >= FIR_Delay(&ecg_fir_detect))
+        r_sample -= FIR_Delay(&ecg_fir_detect);
+    if (r_sample >= ecg_iir_delay)
+        r_sample -= ecg_iir_delay;
+    // 从R峰到检出的延迟：当前样本距R峰的样本数，加上当前样本的处理时间
+    ECG_LAT_PATH(DETECT, (qrs.n - 1 - r_sample) * ecg_sample_ticks);
+
+    if (ecg_hrv_window != ecg_config.hrv_window)
+    {
+        ecg_hrv_window = ecg_config.hrv_window;
+        HRV_Init(&ecg_hrv, ecg_hrv_window);
+    }
+    HRV_AddBeat(&ecg_hrv, (uint32_t)((uint64_t)r_sample * 1000u / ecg_config.sample_rate));
+
+    if (ecg_config.telemetry & ECG_TLM_QRS)
+    {
+        ecg_port->telemetry("r_peak", (long)r_sample);
+        ecg_port->telemetry("rr_ms", (long)(qrs.rr * 1000u / ecg_config.sample_rate));
+        ecg_port->telemetry("bpm", (long)qrs.bpm);
+    }
+    if (ecg_config.display_mode != ECG_DISPLAY_OFF && ecg_port->show_heart_rate != NULL)
+    {
+        ecg_port->show_heart_rate((uint32_t)qrs.bpm);
+    }
+}
+
+/**
+ * @brief 抽取后频谱支路的采样率，Hz
+ */
+static float ecg_spectrum_fs(void)
+{
+    return (float)ecg_config.sample_rate / ecg_decim.factor;
+}
+
+/**
+ * @brief 按当前窗函数与抽取后的采样率初始化功率谱估计，已有的平均结果清空
+ */
+static void ecg_welch_init(void)
+{
+    ecg_welch_window = ecg_config.welch_window;
+    ecg_welch_avg = ecg_config.welch_avg;
+    WELCH_Init(&ecg_welch, FFT_LENGTH, ecg_welch_window, ecg_spectrum_fs());
+    WELCH_Config(&ecg_welch, ecg_config.fft_hop, ecg_welch_avg);
+    // 频点间隔为 fs/decim/FFT_LENGTH，起始点随采样率与抽取倍数换算
+    WELCH_SetPeakFrom(&ecg_welch, (uint16_t)ceilf(ECG_PEAK_MIN_HZ * FFT_LENGTH / ecg_spectrum_fs()));
+    WSTAT_Init(&ecg_window, ecg_welch.ring, FFT_LENGTH); // 环形缓冲区已清空，窗口统计随之重新开始
+}
+
+/**
+ * @brief 将ECG数据存入环形缓冲区，同时更新窗口统计
+ *        窗口统计读同一个环形缓冲区，须在样本写入前更新，以取得将被覆盖的最早样本
+ * @return 1:已积累fft_hop个新样本，应处理一个分段
+ */
+static uint8_t update_ecg_buffer(ecg_data_t new_ecg_data)
+{
+    WSTAT_Push(&ecg_window, new_ecg_data);
+    return WELCH_Push(&ecg_welch, new_ecg_data);
+}
+
+/**
+ * @brief 波形点的显示坐标：ecg_height非0时按窗口内最小/最大值缩放到 0~ecg_height-1，
+ *        范围过小时以中点为中心按最小范围显示，避免放大噪声
+ */
+static int32_t ecg_display_y(ecg_data_t x)
+{
+    uint16_t h = ecg_port->ecg_height;
+    int32_t lo, hi;
+    float y;
+
+    if (h == 0 || ecg_window.count == 0)
+        return ECG_TO_DISPLAY(x);
+    lo = WSTAT_Min(&ecg_window);
+    hi = WSTAT_Max(&ecg_window);
+    if (hi - lo < ECG_AUTOSCALE_MIN_SPAN)
+    {
+        lo = lo + (hi - lo) / 2 - ECG_AUTOSCALE_MIN_SPAN / 2;
+        hi = lo + ECG_AUTOSCALE_MIN_SPAN;
+    }
+    y = (float)(ECG_TO_COUNTS(x) - lo) * (h - 1) / (float)(hi - lo);
+    if (y < 0.0f)
+        return 0;
+    if (y > h - 1)
+        return h - 1;
+    return (int32_t)y;
+}
+
+/**
+ * @brief 由频谱峰值计算频率，并输出窗口内的峰峰值，峰值已在累加功率谱时搜索得到
+ *        每个分段都调用，遥测不受显示模式影响，只有峰峰值的显示在波形+频谱模式下进行
+ *        窗口为抽取后的样本，R波尖峰可能落在两个抽取点之间，decim>1时峰峰值略偏小，
+ *        全速率显示的R波顶点也可能被自动缩放限幅
+ */
+static void ecg_spectrum_process(void)
+{
+    float frequency = ecg_spectrum_fs() * ecg_welch.peak_bin / FFT_LENGTH;
+    int32_t p2p = WSTAT_Max(&ecg_window) - WSTAT_Min(&ecg_window);
+
+    if (ecg_config.telemetry & ECG_TLM_FREQ)
+    {
+        ecg_port->telemetry("frequency", (long)frequency);
+    }
+    if (ecg_config.telemetry & ECG_TLM_STATS)
+    {
+        ecg_port->telemetry("p2p", (long)p2p);
+        ecg_port->telemetry("mean", (long)WSTAT_Mean(&ecg_window));
+        ecg_port->telemetry("std", (long)WSTAT_Std(&ecg_window));
+    }
+
+    // 峰峰值显示刻度为24位数据的高16位
+    if (ecg_config.display_mode == ECG_DISPLAY_ALL && ecg_port->show_peak_to_peak != NULL)
+    {
+        ecg_port->show_peak_to_peak((uint32_t)(p2p >> 8));
+    }
+}
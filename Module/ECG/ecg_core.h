@@ -0,0 +1,27 @@
+#ifndef ECG_CORE_H
+#define ECG_CORE_H
+
+#include "stdint.h"
+#include "ecg_port.h"
+#include "hrv.h"
+#include "wstat.h"
+
+/*
+ * ECG信号处理核心：帧解析 -> FIR -> 环形缓冲区 -> QRS检测 -> Welch功率谱
+ * 只通过 ECG_Port_t 访问硬件，不依赖HAL，可在主机端编译运行
+ * 配置与计数器使用 ecg_cmd.h 中的 ecg_config / ecg_counter
+ */
+
+#define ECG_FFT_LENGTH 1024 // 功率谱的分段长度，也是环形缓冲区长度
+
+void ECG_Core_Init(const ECG_Port_t *port);          // 初始化滤波器、FFT与QRS检测
+void ECG_Core_SetSampleRate(uint16_t sps);           // 采样率改变后重置与采样率相关的状态
+uint8_t ECG_Core_Poll(void);                         // 从采样源读取并处理一帧，有新帧时返回1
+void ECG_Core_Process(const uint8_t *raw, uint32_t stamp); // 处理一帧原始数据
+void ECG_Core_Idle(void);                            // 没有新帧时调用，推进HRV频域等后台计算
+float ECG_Core_BandPower(uint8_t band);              // 跟踪频带最近一块的功率，24位刻度的平方，band见 ECG_BAND_xxx
+const WSTAT_t *ECG_Core_Window(void);               // 环形缓冲区窗口的统计，用于信号质量判断，刻度为24位样本
+uint32_t ECG_Core_Bench(uint32_t samples);           // 用合成ECG驱动信号链测量各阶段耗时(记入PROF)，返回总时钟数
+const HRV_t *ECG_Core_Hrv(void);                     // 心率变异性状态，时域指标用 HRV_GetTime 读取
+
+#endif // !ECG_CORE_H
@@ -0,0 +1,42 @@
+#ifndef ECG_PORT_H
+#define ECG_PORT_H
+
+#include "stdint.h"
+#include "ecg_conf.h"
+
+/*
+ * 信号处理核心与硬件之间的接口：采样源、显示、遥测、时钟
+ * 固件实现见 Application/ecg_task.c，主机实现见 Host/ecg_port_host.c
+ */
+
+/* 信号链数据类型，浮点模式为float，定点模式为Q31 */
+#if ECG_USE_FIXED_POINT
+typedef int32_t ecg_data_t;
+#else
+typedef float ecg_data_t;
+#endif
+typedef float ecg_spec_t; // 频谱显示值，归一化到0~1，两种模式下都为float
+
+typedef struct
+{
+    /* 采样源：有新帧时写入 ADS1292R_FRAME_SIZE 字节与DRDY时刻并返回1 */
+    uint8_t (*read_frame)(uint8_t *raw, uint32_t *stamp);
+
+    /* 显示，不需要的项可为NULL */
+    void (*draw_ecg)(int32_t y);                                // 追加一个波形点，见ecg_height
+    uint16_t ecg_height;                                        // 波形区高度，非0时波形点按窗口内最小/最大值缩放到
+                                                                // 0~ecg_height-1，0时刻度为24位样本的高16位
+    void (*draw_spectrum)(const ecg_spec_t *spec, uint16_t columns); // 频谱，每列一个0~1的值
+    uint16_t spectrum_width;                                        // 频谱的列数，0时每个频点一列
+    void (*show_heart_rate)(uint32_t bpm);
+    void (*show_peak_to_peak)(uint32_t p2p);
+
+    /* 遥测：输出一个命名的数值 */
+    void (*telemetry)(const char *name, long value);
+
+    /* 时钟：与DRDY时刻同单位 */
+    uint32_t (*now)(void);
+    uint32_t clock_hz; // 时钟频率，用于换算采样周期
+} ECG_Port_t;
+
+#endif // !ECG_PORT_H
@@ -0,0 +1,146 @@
+#include "ecg_fft.h"
+#include <math.h>
+
+#ifdef ARM_MATH_CM4
+
+void FFT_Init(FFT_t *fft, uint16_t len)
+{
+    fft->len = len;
+#if ECG_USE_FIXED_POINT
+    arm_rfft_init_q31(&fft->q31, len, 0, 1);
+#else
+    arm_rfft_fast_init_f32(&fft->f32, len);
+#endif
+}
+
+#if ECG_USE_FIXED_POINT
+void FFT_RealQ31(FFT_t *fft, int32_t *in, int32_t *out)
+{
+    arm_rfft_q31(&fft->q31, in, out);
+}
+#else
+void FFT_Real(FFT_t *fft, float *in, float *out)
+{
+    arm_rfft_fast_f32(&fft->f32, in, out, 0);
+}
+#endif
+
+void FFT_MagQ31(const int32_t *in, int32_t *out, uint16_t num)
+{
+    arm_cmplx_mag_q31((q31_t *)in, out, num);
+}
+
+void FFT_MagSquared(const float *in, float *out, uint16_t num)
+{
+    arm_cmplx_mag_squared_f32((float32_t *)in, out, num);
+}
+
+#else
+
+#define FFT_PI 3.14159265358979323846
+
+/**
+ * @brief 原位基2复数FFT，data为len个交替存放的实部/虚部
+ */
+static void fft_complex(double *data, uint32_t len)
+{
+    for (uint32_t i = 1, j = 0; i < len; i++)
+    {
+        uint32_t bit = len >> 1;
+        for (; j & bit; bit >>= 1)
+            j ^= bit;
+        j |= bit;
+        if (i < j)
+        {
+            double tr = data[2 * i], ti = data[2 * i + 1];
+            data[2 * i] = data[2 * j];
+            data[2 * i + 1] = data[2 * j + 1];
+            data[2 * j] = tr;
+            data[2 * j + 1] = ti;
+        }
+    }
+    for (uint32_t size = 2; size <= len; size <<= 1)
+    {
+        double ang = -2.0 * FFT_PI / size;
+        double wr_step = cos(ang), wi_step = sin(ang);
+        for (uint32_t start = 0; start < len; start += size)
+        {
+            double wr = 1.0, wi = 0.0;
+            for (uint32_t k = 0; k < size / 2; k++)
+            {
+                uint32_t a = 2 * (start + k), b = 2 * (start + k + size / 2);
+                double tr = data[b] * wr - data[b + 1] * wi;
+                double ti = data[b] * wi + data[b + 1] * wr;
+                double t = wr * wr_step - wi * wi_step;
+                data[b] = data[a] - tr;
+                data[b + 1] = data[a + 1] - ti;
+                data[a] += tr;
+                data[a + 1] += ti;
+                wi = wr * wi_step + wi * wr_step;
+                wr = t;
+            }
+        }
+    }
+}
+
+void FFT_Init(FFT_t *fft, uint16_t len)
+{
+    fft->len = len;
+}
+
+#if !ECG_USE_FIXED_POINT
+void FFT_Real(FFT_t *fft, float *in, float *out)
+{
+    static double buf[2 * 4096];
+    uint32_t len = fft->len;
+
+    for (uint32_t i = 0; i < len; i++)
+    {
+        buf[2 * i] = in[i];
+        buf[2 * i + 1] = 0.0;
+    }
+    fft_complex(buf, len);
+    out[0] = (float)buf[0];
+    out[1] = (float)buf[len]; // 奈奎斯特分量为实数
+    for (uint32_t k = 1; k < len / 2; k++)
+    {
+        out[2 * k] = (float)buf[2 * k];
+        out[2 * k + 1] = (float)buf[2 * k + 1];
+    }
+}
+#else
+void FFT_RealQ31(FFT_t *fft, int32_t *in, int32_t *out)
+{
+    static double buf[2 * 4096];
+    uint32_t len = fft->len;
+
+    for (uint32_t i = 0; i < len; i++)
+    {
+        buf[2 * i] = in[i];
+        buf[2 * i + 1] = 0.0;
+    }
+    fft_complex(buf, len);
+    for (uint32_t i = 0; i < 2 * len; i++)
+        out[i] = (int32_t)(buf[i] / len);
+}
+#endif
+
+void FFT_MagQ31(const int32_t *in, int32_t *out, uint16_t num)
+{
+    for (uint16_t i = 0; i < num; i++)
+    {
+        double re = in[2 * i], im = in[2 * i + 1];
+        out[i] = (int32_t)(sqrt(re * re + im * im) / 2.0);
+    }
+}
+
+void FFT_MagSquared(const float *in, float *out, uint16_t num)
+{
+    for (uint16_t i = 0; i < num; i++)
+    {
+        float re = in[2 * i], im = in[2 * i + 1];
+        out[i] = re * re + im * im;
+    }
+}
+
+#endif
@@ -0,0 +1,42 @@
+#ifndef ECG_FFT_H
+#define ECG_FFT_H
+
+#include "stdint.h"
+
+/*
+ * 实数FFT封装：固件中调用CMSIS-DSP，主机端用基2实现，两者输出格式一致
+ *   FFT_Real    与 arm_rfft_fast_f32 相同：out[0]=直流, out[1]=奈奎斯特, 之后为实部/虚部交替
+ *   FFT_RealQ31 与 arm_rfft_q31 相同：输出 len 个复数(2*len 个值)，按 1/len 缩放
+ *   FFT_MagSquared 与 arm_cmplx_mag_squared_f32 相同，可原位计算
+ * 长度为2的幂，32~4096
+ * 只编译当前信号链用到的一种：ECG_USE_FIXED_POINT 为1时只有 FFT_RealQ31，否则只有 FFT_Real
+ */
+
+#include "ecg_conf.h"
+
+#ifdef ARM_MATH_CM4
+#include "arm_math.h"
+#endif
+
+typedef struct
+{
+    uint16_t len;
+#ifdef ARM_MATH_CM4
+#if ECG_USE_FIXED_POINT
+    arm_rfft_instance_q31 q31;
+#else
+    arm_rfft_fast_instance_f32 f32;
+#endif
+#endif
+} FFT_t;
+
+void FFT_Init(FFT_t *fft, uint16_t len);                  // 按长度初始化
+#if ECG_USE_FIXED_POINT
+void FFT_RealQ31(FFT_t *fft, int32_t *in, int32_t *out);  // Q31实数FFT，会改写in
+#else
+void FFT_Real(FFT_t *fft, float *in, float *out);         // 浮点实数FFT，会改写in
+#endif
+void FFT_MagQ31(const int32_t *in, int32_t *out, uint16_t num); // Q31复数求模，结果为2.30格式
+void FFT_MagSquared(const float *in, float *out, uint16_t num);  // 浮点复数模的平方，不开方
+
+#endif // !ECG_FFT_H
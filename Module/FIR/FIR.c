@@ -0,0 +1,144 @@
+#include "FIR.h"
+#include <math.h>
+#include <string.h>
+
+#ifdef ARM_MATH_CM4
+#include "arm_math.h"
+#define FIR_SMLALD(x, y, acc) ((int64_t)__SMLALD((x), (y), (uint64_t)(acc)))
+#else
+// 主机端没有DSP扩展指令，用等价的C实现
+static inline int64_t FIR_SMLALD(uint32_t x, uint32_t y, int64_t acc)
+{
+    return acc + (int32_t)(int16_t)x * (int16_t)y + (int32_t)(int16_t)(x >> 16) * (int16_t)(y >> 16);
+}
+#endif
+
+/**
+ * @brief 清空输入历史并选择设计
+ */
+void FIR_Init(FIR_t *fir, const FIR_Design_t *design)
+{
+    memset(fir, 0, sizeof(FIR_t));
+    FIR_Select(fir, design);
+}
+
+/**
+ * @brief 切换设计，定点时在此生成定点系数，不影响输入历史
+ */
+void FIR_Select(FIR_t *fir, const FIR_Design_t *design)
+{
+    uint16_t taps = design->taps > FIR_MAX_TAPS ? FIR_MAX_TAPS : design->taps;
+
+#if !ECG_USE_FIXED_POINT
+    fir->coeffs = design->coeffs;
+#elif !ECG_FIR_Q15
+    for (uint16_t i = 0; i < taps; i++)
+    {
+        float q31 = roundf(design->coeffs[i] * 2147483648.0f);
+
+        fir->coeffs_q31[i] = q31 >= 2147483647.0f ? INT32_MAX : (int32_t)q31;
+    }
+#else
+    memset(fir->coeffs_q15, 0, sizeof(fir->coeffs_q15));
+    for (uint16_t i = 0; i < taps; i++)
+    {
+        float q15 = roundf(design->coeffs[i] * 32768.0f);
+
+        fir->coeffs_q15[i] = q15 >= 32767.0f ? INT16_MAX : (int16_t)q15;
+    }
+    fir->taps_even = (taps + 1) & ~1;
+#endif
+    fir->taps = taps;
+    fir->design = design;
+}
+
+uint16_t FIR_Delay(const FIR_t *fir)
+{
+    return fir->design->delay;
+}
+
+#if !ECG_USE_FIXED_POINT
+/**
+ * @brief 浮点FIR
+ * @param input: 输入样本
+ * @return 滤波结果，与输入同一刻度
+ */
+ECG_RAMFUNC(FIR) float FIR_filter(FIR_t *fir, float input)
+{
+    float output = 0.0f;
+    const float *x;
+
+    // 新样本写入两处，x[0..MAX-1]依次为x(n)...x(n-MAX+1)
+    fir->pos = fir->pos == 0 ? FIR_MAX_TAPS - 1 : fir->pos - 1;
+    fir->state[fir->pos] = input;
+    fir->state[fir->pos + FIR_MAX_TAPS] = input;
+    x = &fir->state[fir->pos];
+
+    for (uint16_t i = 0; i < fir->taps; i++)
+    {
+        output += x[i] * fir->coeffs[i];
+    }
+
+    return output;
+}
+#elif !ECG_FIR_Q15
+/**
+ * @brief Q31定点FIR，64位累加(SMLAL)，保留24位采样的全部精度
+ * @param input: Q31格式输入
+ * @return Q31格式输出，饱和到Q31范围
+ */
+ECG_RAMFUNC(FIR) int32_t FIR_filter_q31(FIR_t *fir, int32_t input)
+{
+    int64_t acc = 0;
+    const int32_t *x;
+
+    fir->pos = fir->pos == 0 ? FIR_MAX_TAPS - 1 : fir->pos - 1;
+    fir->state_q31[fir->pos] = input;
+    fir->state_q31[fir->pos + FIR_MAX_TAPS] = input;
+    x = &fir->state_q31[fir->pos];
+
+    for (uint16_t i = 0; i < fir->taps; i++)
+    {
+        acc += (int64_t)fir->coeffs_q31[i] * x[i];
+    }
+
+    acc >>= 31;
+    if (acc > INT32_MAX)
+        acc = INT32_MAX;
+    else if (acc < INT32_MIN)
+        acc = INT32_MIN;
+    return (int32_t)acc;
+}
+#else
+/**
+ * @brief Q15定点FIR，每次取两个系数和两个样本做双MAC(SMLALD)
+ * @note  累加器为64位，输入满幅时也不会溢出；信号幅度有保证时可换成32位累加的__SMLAD
+ * @param input: Q15格式输入
+ * @return Q15格式输出，饱和到Q15范围
+ */
+ECG_RAMFUNC(FIR) int16_t FIR_filter_q15(FIR_t *fir, int16_t input)
+{
+    int64_t acc = 0;
+    const int16_t *x;
+    uint32_t x2, c2;
+
+    fir->pos = fir->pos == 0 ? FIR_MAX_TAPS_EVEN - 1 : fir->pos - 1;
+    fir->state_q15[fir->pos] = input;
+    fir->state_q15[fir->pos + FIR_MAX_TAPS_EVEN] = input;
+    x = &fir->state_q15[fir->pos];
+
+    for (uint16_t i = 0; i < fir->taps_even; i += 2)
+    {
+        memcpy(&x2, &x[i], sizeof(x2)); // Cortex-M4允许非对齐的LDR
+        memcpy(&c2, &fir->coeffs_q15[i], sizeof(c2));
+        acc = FIR_SMLALD(x2, c2, acc);
+    }
+
+    acc >>= 15;
+    if (acc > INT16_MAX)
+        acc = INT16_MAX;
+    else if (acc < INT16_MIN)
+        acc = INT16_MIN;
+    return (int16_t)acc;
+}
+#endif
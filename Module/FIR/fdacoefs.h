@@ -1,67 +0,0 @@
-/*
- * Filter Coefficients (C Source) generated by the Filter Design and Analysis Tool
- * Generated by MATLAB(R) 9.13 and Signal Processing Toolbox 9.1.
- * Generated on: 25-Dec-2024 18:13:50
- */
-
-/*
- * 离散时间 FIR 滤波器(实数)
- * ----------------
- * 滤波器结构  : 直接型 FIR
- * 滤波器长度  : 181
- * 稳定     : 是
- * 线性相位   : 是 (Type 1)
- */
-
-/* General type conversion for MATLAB generated C-code  */
-#include "tmwtypes.h"
-/* 
- * Expected path to tmwtypes.h 
- * D:\Matlab\extern\include\tmwtypes.h 
- */
-/*
- * Warning - Filter coefficients were truncated to fit specified data type.  
- *   The resulting response may not match generated theoretical response.
- *   Use the Filter Design & Analysis Tool to design accurate
- *   single-precision filter coefficients.
- */
-const int BL = 181;
-const real32_T B[181] = {
-  1.939705863e-18, 0.000232159975,0.0002789109712,9.324662096e-05,-0.0001836826996,
-  -0.0003255770134,-0.0002004677081,0.0001109399527,0.0003609354899,0.0003257369099,
-  -1.259290252e-18,-0.0003697601205,-0.0004645876179,-0.0001615776127,0.0003293180198,
-  0.0006007585907,0.0003787857131,-0.0002136440453,-0.0007053618319,-0.0006434956449,
-  -8.364509291e-19, 0.000739130599,0.0009304012056,0.0003234766191,-0.0006578819593,
-   -0.00119578396,-0.0007503046654,0.0004207296297, 0.001379942754, 0.001249909168,
-  -3.623305441e-18,-0.001413577236,-0.001765040681,-0.0006086557405, 0.001227758476,
-   0.002213470405, 0.001377710025,-0.0007664522855,-0.002494501416,-0.002242509043,
-  1.577892017e-17, 0.002500125207, 0.003100758884, 0.001062390395,-0.002129897708,
-  -0.003817617428,-0.002363164444, 0.001307940227, 0.004236496519,  0.00379171758,
-  -7.245186477e-18,-0.004194836132,  -0.0051856637,-0.001771670417, 0.003543282859,
-   0.006338419858, 0.003917648457,-0.002166072838,-0.007012404036,-0.006276306696,
-  8.999823499e-18, 0.006955934223,  0.00861474406,  0.00295065972,-0.005920577794,
-   -0.01063438412,-0.006605596747, 0.003673949745,  0.01197736338,  0.01080793049,
-  -1.043021565e-17, -0.01222517714, -0.01533240173,-0.005328103434,  0.01087027416,
-     0.0199019108,  0.01263759658,-0.007210176904, -0.02421095408, -0.02261413634,
-  1.136383869e-17,  0.02795354091,  0.03714657202,  0.01385225169, -0.03085253946,
-   -0.06318230182, -0.04653945193,  0.03268710524,   0.1511125565,   0.2573043108,
-     0.2998349667,   0.2573043108,   0.1511125565,  0.03268710524, -0.04653945193,
-   -0.06318230182, -0.03085253946,  0.01385225169,  0.03714657202,  0.02795354091,
-  1.136383869e-17, -0.02261413634, -0.02421095408,-0.007210176904,  0.01263759658,
-     0.0199019108,  0.01087027416,-0.005328103434, -0.01533240173, -0.01222517714,
-  -1.043021565e-17,  0.01080793049,  0.01197736338, 0.003673949745,-0.006605596747,
-   -0.01063438412,-0.005920577794,  0.00295065972,  0.00861474406, 0.006955934223,
-  8.999823499e-18,-0.006276306696,-0.007012404036,-0.002166072838, 0.003917648457,
-   0.006338419858, 0.003543282859,-0.001771670417,  -0.0051856637,-0.004194836132,
-  -7.245186477e-18,  0.00379171758, 0.004236496519, 0.001307940227,-0.002363164444,
-  -0.003817617428,-0.002129897708, 0.001062390395, 0.003100758884, 0.002500125207,
-  1.577892017e-17,-0.002242509043,-0.002494501416,-0.0007664522855, 0.001377710025,
-   0.002213470405, 0.001227758476,-0.0006086557405,-0.001765040681,-0.001413577236,
-  -3.623305441e-18, 0.001249909168, 0.001379942754,0.0004207296297,-0.0007503046654,
-   -0.00119578396,-0.0006578819593,0.0003234766191,0.0009304012056, 0.000739130599,
-  -8.364509291e-19,-0.0006434956449,-0.0007053618319,-0.0002136440453,0.0003787857131,
-  0.0006007585907,0.0003293180198,-0.0001615776127,-0.0004645876179,-0.0003697601205,
-  -1.259290252e-18,0.0003257369099,0.0003609354899,0.0001109399527,-0.0002004677081,
-  -0.0003255770134,-0.0001836826996,9.324662096e-05,0.0002789109712, 0.000232159975,
-  1.939705863e-18
-};
@@ -0,0 +1,483 @@
+#include "fir_bank.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+/*
+ * 除原MATLAB设计外，系数均为Kaiser窗法设计的低通，直流增益归一化为1：
+ *   monitor  截止45Hz，β=6，阶数约为 fs*0.386，40Hz以内平坦，50Hz起衰减60dB以上
+ *   diag     截止165Hz(250SPS时110Hz)，β=6
+ *   lowlat   截止55Hz(250SPS时50Hz)，β=3，阶数为 fs/25+1
+ *   minphase 由monitor经倒谱法转换为最小相位，幅频响应相同，
+ *            QRS频段(5~20Hz)的群延迟约为 fs/50 个样本，记录的是10Hz处的值
+ */
+
+/* 原MATLAB(R) 9.13 Filter Design and Analysis Tool 设计，500SPS，75Hz低通 */
+static const float fir_legacy_500[181] = {
+    1.939705863e-18, 0.000232159975, 0.0002789109712, 9.324662096e-05, -0.0001836826996,
+    -0.0003255770134, -0.0002004677081, 0.0001109399527, 0.0003609354899, 0.0003257369099,
+    -1.259290252e-18, -0.0003697601205, -0.0004645876179, -0.0001615776127, 0.0003293180198,
+    0.0006007585907, 0.0003787857131, -0.0002136440453, -0.0007053618319, -0.0006434956449,
+    -8.364509291e-19, 0.000739130599, 0.0009304012056, 0.0003234766191, -0.0006578819593,
+    -0.00119578396, -0.0007503046654, 0.0004207296297, 0.001379942754, 0.001249909168,
+    -3.623305441e-18, -0.001413577236, -0.001765040681, -0.0006086557405, 0.001227758476,
+    0.002213470405, 0.001377710025, -0.0007664522855, -0.002494501416, -0.002242509043,
+    1.577892017e-17, 0.002500125207, 0.003100758884, 0.001062390395, -0.002129897708,
+    -0.003817617428, -0.002363164444, 0.001307940227, 0.004236496519, 0.00379171758,
+    -7.245186477e-18, -0.004194836132, -0.0051856637, -0.001771670417, 0.003543282859,
+    0.006338419858, 0.003917648457, -0.002166072838, -0.007012404036, -0.006276306696,
+    8.999823499e-18, 0.006955934223, 0.00861474406, 0.00295065972, -0.005920577794,
+    -0.01063438412, -0.006605596747, 0.003673949745, 0.01197736338, 0.01080793049,
+    -1.043021565e-17, -0.01222517714, -0.01533240173, -0.005328103434, 0.01087027416,
+    0.0199019108, 0.01263759658, -0.007210176904, -0.02421095408, -0.02261413634,
+    1.136383869e-17, 0.02795354091, 0.03714657202, 0.01385225169, -0.03085253946,
+    -0.06318230182, -0.04653945193, 0.03268710524, 0.1511125565, 0.2573043108,
+    0.2998349667, 0.2573043108, 0.1511125565, 0.03268710524, -0.04653945193,
+    -0.06318230182, -0.03085253946, 0.01385225169, 0.03714657202, 0.02795354091,
+    1.136383869e-17, -0.02261413634, -0.02421095408, -0.007210176904, 0.01263759658,
+    0.0199019108, 0.01087027416, -0.005328103434, -0.01533240173, -0.01222517714,
+    -1.043021565e-17, 0.01080793049, 0.01197736338, 0.003673949745, -0.006605596747,
+    -0.01063438412, -0.005920577794, 0.00295065972, 0.00861474406, 0.006955934223,
+    8.999823499e-18, -0.006276306696, -0.007012404036, -0.002166072838, 0.003917648457,
+    0.006338419858, 0.003543282859, -0.001771670417, -0.0051856637, -0.004194836132,
+    -7.245186477e-18, 0.00379171758, 0.004236496519, 0.001307940227, -0.002363164444,
+    -0.003817617428, -0.002129897708, 0.001062390395, 0.003100758884, 0.002500125207,
+    1.577892017e-17, -0.002242509043, -0.002494501416, -0.0007664522855, 0.001377710025,
+    0.002213470405, 0.001227758476, -0.0006086557405, -0.001765040681, -0.001413577236,
+    -3.623305441e-18, 0.001249909168, 0.001379942754, 0.0004207296297, -0.0007503046654,
+    -0.00119578396, -0.0006578819593, 0.0003234766191, 0.0009304012056, 0.000739130599,
+    -8.364509291e-19, -0.0006434956449, -0.0007053618319, -0.0002136440453, 0.0003787857131,
+    0.0006007585907, 0.0003293180198, -0.0001615776127, -0.0004645876179, -0.0003697601205,
+    -1.259290252e-18, 0.0003257369099, 0.0003609354899, 0.0001109399527, -0.0002004677081,
+    -0.0003255770134, -0.0001836826996, 9.324662096e-05, 0.0002789109712, 0.000232159975,
+    1.939705863e-18};
+
+static const float fir_bypass[1] = {1.0f};
+
+static const float fir_monitor_250[97] = {
+    -7.599201626e-05, 3.524321717e-05, 0.0001901230018, 0.0001499687683, -0.0001578023076,
+    -0.0004111186407, -0.0001875441062, 0.0004253777002, 0.0007124243984, 0.0001120381128,
+    -0.0008927771771, -0.001047834897, 0.0001812958237, 0.001593567477, 0.001321232653,
+    -0.0008142962442, -0.002518510385, -0.001381092708, 0.001907029406, 0.003594274704,
+    0.001023047295, -0.003553388624, -0.004665915622, 6.340693169e-18, 0.005795384076,
+    0.005484905433, -0.001964620595, -0.008601496386, -0.005700112817, 0.005170990593,
+    0.01185448395, 0.004839548975, -0.009966738394, -0.01535276631, -0.002247123383,
+    0.01685429952, 0.01882711397, -0.003135543335, -0.02684858119, -0.02197132043,
+    0.01356742894, 0.04280184351, 0.02448248228, -0.03631947734, -0.07668871104,
+    -0.02610418373, 0.1220411444, 0.2876539054, 0.359975588, 0.2876539054,
+    0.1220411444, -0.02610418373, -0.07668871104, -0.03631947734, 0.02448248228,
+    0.04280184351, 0.01356742894, -0.02197132043, -0.02684858119, -0.003135543335,
+    0.01882711397, 0.01685429952, -0.002247123383, -0.01535276631, -0.009966738394,
+    0.004839548975, 0.01185448395, 0.005170990593, -0.005700112817, -0.008601496386,
+    -0.001964620595, 0.005484905433, 0.005795384076, 6.340693169e-18, -0.004665915622,
+    -0.003553388624, 0.001023047295, 0.003594274704, 0.001907029406, -0.001381092708,
+    -0.002518510385, -0.0008142962442, 0.001321232653, 0.001593567477, 0.0001812958237,
+    -0.001047834897, -0.0008927771771, 0.0001120381128, 0.0007124243984, 0.0004253777002,
+    -0.0001875441062, -0.0004111186407, -0.0001578023076, 0.0001499687683, 0.0001901230018,
+    3.524321717e-05, -7.599201626e-05};
+
+static const float fir_monitor_500[193] = {
+    -3.79943742e-05, -1.840703024e-05, 1.762085081e-05, 6.067621293e-05, 9.5057413e-05,
+    0.0001036943931, 7.498115963e-05, 9.101962452e-06, -7.889776083e-05, -0.0001613109897,
+    -0.0002055504808, -0.0001856506698, -9.376802066e-05, 5.279671143e-05, 0.0002126797039,
+    0.0003308487967, 0.0003561968812, 0.000261100144, 5.601664743e-05, -0.000207181294,
+    -0.0004463693927, -0.0005732658555, -0.0005238949189, -0.0002854584944, 9.064401378e-05,
+    0.0004965261557, 0.0007967494748, 0.0008714590364, 0.0006605879183, 0.0001936962428,
+    -0.0004071306137, -0.0009561842508, -0.001259201041, -0.001179027223, -0.0006905166585,
+    9.578797743e-05, 0.0009534736995, 0.00160237866, 0.001797060071, 0.001414582365,
+    0.0005115016508, -0.0006731795741, -0.00177661791, -0.002419703531, -0.002332857488,
+    -0.001459554412, 3.170210251e-18, 0.001626590654, 0.00289756743, 0.003350068884,
+    0.002742334784, 0.001158806603, -0.0009822680554, -0.003031759728, -0.00430056325,
+    -0.004284199793, -0.002849933849, -0.0003203122738, 0.002585384114, 0.004947130797,
+    0.005926987089, 0.005054324406, 0.002419670431, -0.001296017094, -0.004983154899,
+    -0.007422953211, -0.007676053052, -0.005420490032, -0.001123513376, 0.00402589082,
+    0.008426787371, 0.01054341851, 0.009413152178, 0.005024863003, -0.001567704249,
+    -0.008462629821, -0.01342371332, -0.01456149342, -0.0109851878, -0.003217639338,
+    0.006783422752, 0.01605042764, 0.02140000146, 0.02039982003, 0.01224071474,
+    -0.001752468831, -0.01815895775, -0.03209739718, -0.03834270662, -0.03266518491,
+    -0.01305153059, 0.01952485624, 0.06101794818, 0.1049739497, 0.1438207678,
+    0.1704894236, 0.1799800541, 0.1704894236, 0.1438207678, 0.1049739497,
+    0.06101794818, 0.01952485624, -0.01305153059, -0.03266518491, -0.03834270662,
+    -0.03209739718, -0.01815895775, -0.001752468831, 0.01224071474, 0.02039982003,
+    0.02140000146, 0.01605042764, 0.006783422752, -0.003217639338, -0.0109851878,
+    -0.01456149342, -0.01342371332, -0.008462629821, -0.001567704249, 0.005024863003,
+    0.009413152178, 0.01054341851, 0.008426787371, 0.00402589082, -0.001123513376,
+    -0.005420490032, -0.007676053052, -0.007422953211, -0.004983154899, -0.001296017094,
+    0.002419670431, 0.005054324406, 0.005926987089, 0.004947130797, 0.002585384114,
+    -0.0003203122738, -0.002849933849, -0.004284199793, -0.00430056325, -0.003031759728,
+    -0.0009822680554, 0.001158806603, 0.002742334784, 0.003350068884, 0.00289756743,
+    0.001626590654, 3.170210251e-18, -0.001459554412, -0.002332857488, -0.002419703531,
+    -0.00177661791, -0.0006731795741, 0.0005115016508, 0.001414582365, 0.001797060071,
+    0.00160237866, 0.0009534736995, 9.578797743e-05, -0.0006905166585, -0.001179027223,
+    -0.001259201041, -0.0009561842508, -0.0004071306137, 0.0001936962428, 0.0006605879183,
+    0.0008714590364, 0.0007967494748, 0.0004965261557, 9.064401378e-05, -0.0002854584944,
+    -0.0005238949189, -0.0005732658555, -0.0004463693927, -0.000207181294, 5.601664743e-05,
+    0.000261100144, 0.0003561968812, 0.0003308487967, 0.0002126797039, 5.279671143e-05,
+    -9.376802066e-05, -0.0001856506698, -0.0002055504808, -0.0001613109897, -7.889776083e-05,
+    9.101962452e-06, 7.498115963e-05, 0.0001036943931, 9.5057413e-05, 6.067621293e-05,
+    1.762085081e-05, -1.840703024e-05, -3.79943742e-05};
+
+static const float fir_monitor_1000[385] = {
+    -1.8996802e-05, -1.52639318e-05, -9.203328551e-06, -1.022050591e-06, 8.810246802e-06,
+    1.957346273e-05, 3.033749146e-05, 4.003001361e-05, 4.752774301e-05, 5.176438751e-05,
+    5.184614551e-05, 4.716381891e-05, 3.748981981e-05, 2.304864772e-05, 4.55088897e-06,
+    -1.681660063e-05, -3.944808072e-05, -6.142332924e-05, -8.065385983e-05, -9.506116736e-05,
+    -0.0001027731569, -0.0001023218172, -9.282345316e-05, -7.412268069e-05, -4.688305991e-05,
+    -1.261069439e-05, 2.639782057e-05, 6.718540682e-05, 0.0001063376963, 0.0001402473925,
+    0.0001654210449, 0.0001788039143, 0.0001780948302, 0.0001620214477, 0.0001305474255,
+    8.498686668e-05, 2.800775594e-05, -3.648529551e-05, -0.000103588547, -0.0001677455149,
+    -0.000223180172, -0.0002643853276, -0.0002866271172, -0.0002864220498, -0.0002619421493,
+    -0.0002133067385, -0.0001427263538, -5.447481515e-05, 4.532108813e-05, 0.0001490694838,
+    0.0002482580451, 0.0003341192125, 0.0003983666616, 0.000433943906, 0.0004357206852,
+    0.0004010728617, 0.0003302872635, 0.0002267441551, 9.684615812e-05, -5.031761146e-05,
+    -0.0002035611802, -0.0003504113716, -0.0004780824336, -0.0005745427139, -0.0006295877574,
+    -0.00063582812, -0.0005895016608, -0.0004910294458, -0.0003452513303, -0.0001613007877,
+    4.789301782e-05, 0.0002664567231, 0.0004767271855, 0.0006606292126, 0.0008011730882,
+    0.0008839519373, 0.0008985118205, 0.0008394707463, 0.0007072768445, 0.0005085201845,
+    0.0002557456409, -3.324651468e-05, -0.0003365829638, -0.000629910743, -0.0008882909473,
+    -0.001088250352, -0.00120982724, -0.001238439075, -0.001166405098, -0.0009939767823,
+    -0.0007297624121, -0.0003904767884, 1.585072993e-18, 0.0004122136599, 0.00081327884,
+    0.001169425046, 0.001448754346, 0.001623992037, 0.001675000486, 0.001590834036,
+    0.001371139596, 0.00102675188, 0.000579391556, 6.044453259e-05, -0.0004911240716,
+    -0.001031593027, -0.001515849134, -0.001901041473, -0.002150238035, -0.002235782245,
+    -0.002142056473, -0.001867393961, -0.001424938038, -0.000842324361, -0.0001601528903,
+    0.000570685573, 0.001292665852, 0.001946016459, 0.002473515255, 0.002825319197,
+    0.002963433469, 0.002865435427, 0.002527110973, 0.001963733165, 0.00120981069,
+    0.0003172503688, -0.0006479954109, -0.001610598465, -0.002491526941, -0.003214308035,
+    -0.003711401367, -0.003930170649, -0.003837948722, -0.003425739742, -0.002710190074,
+    -0.001733581205, -0.0005617453, 0.0007200335833, 0.002012904604, 0.00321173894,
+    0.004213308272, 0.004924742341, 0.005271602388, 0.005204904935, 0.004706480678,
+    0.003792154643, 0.00251238057, 0.0009501451673, -0.0007838362345, -0.002558397135,
+    -0.004231229134, -0.005659600566, -0.006711720597, -0.007277895843, -0.007280599119,
+    -0.006682608813, -0.005492482557, -0.003766795041, -0.001608787056, 0.000836673207,
+    0.00339164262, 0.005856723032, 0.008025051135, 0.009697750295, 0.01069978382,
+    0.01089506811, 0.01019970325, 0.008592261042, 0.006120233298, 0.002901976897,
+    -0.0008762166526, -0.004967971119, -0.00907929482, -0.01288503404, -0.01604837325,
+    -0.01824219806, -0.01917096467, -0.01859163644, -0.01633226136, -0.01230687684,
+    -0.006525633007, 0.0009006879641, 0.009762230218, 0.01975778498, 0.03050835562,
+    0.04157585962, 0.05248591087, 0.06275334188, 0.07190892615, 0.07952566155,
+    0.08524298374, 0.08878739397, 0.08998820277, 0.08878739397, 0.08524298374,
+    0.07952566155, 0.07190892615, 0.06275334188, 0.05248591087, 0.04157585962,
+    0.03050835562, 0.01975778498, 0.009762230218, 0.0009006879641, -0.006525633007,
+    -0.01230687684, -0.01633226136, -0.01859163644, -0.01917096467, -0.01824219806,
+    -0.01604837325, -0.01288503404, -0.00907929482, -0.004967971119, -0.0008762166526,
+    0.002901976897, 0.006120233298, 0.008592261042, 0.01019970325, 0.01089506811,
+    0.01069978382, 0.009697750295, 0.008025051135, 0.005856723032, 0.00339164262,
+    0.000836673207, -0.001608787056, -0.003766795041, -0.005492482557, -0.006682608813,
+    -0.007280599119, -0.007277895843, -0.006711720597, -0.005659600566, -0.004231229134,
+    -0.002558397135, -0.0007838362345, 0.0009501451673, 0.00251238057, 0.003792154643,
+    0.004706480678, 0.005204904935, 0.005271602388, 0.004924742341, 0.004213308272,
+    0.00321173894, 0.002012904604, 0.0007200335833, -0.0005617453, -0.001733581205,
+    -0.002710190074, -0.003425739742, -0.003837948722, -0.003930170649, -0.003711401367,
+    -0.003214308035, -0.002491526941, -0.001610598465, -0.0006479954109, 0.0003172503688,
+    0.00120981069, 0.001963733165, 0.002527110973, 0.002865435427, 0.002963433469,
+    0.002825319197, 0.002473515255, 0.001946016459, 0.001292665852, 0.000570685573,
+    -0.0001601528903, -0.000842324361, -0.001424938038, -0.001867393961, -0.002142056473,
+    -0.002235782245, -0.002150238035, -0.001901041473, -0.001515849134, -0.001031593027,
+    -0.0004911240716, 6.044453259e-05, 0.000579391556, 0.00102675188, 0.001371139596,
+    0.001590834036, 0.001675000486, 0.001623992037, 0.001448754346, 0.001169425046,
+    0.00081327884, 0.0004122136599, 1.585072993e-18, -0.0003904767884, -0.0007297624121,
+    -0.0009939767823, -0.001166405098, -0.001238439075, -0.00120982724, -0.001088250352,
+    -0.0008882909473, -0.000629910743, -0.0003365829638, -3.324651468e-05, 0.0002557456409,
+    0.0005085201845, 0.0007072768445, 0.0008394707463, 0.0008985118205, 0.0008839519373,
+    0.0008011730882, 0.0006606292126, 0.0004767271855, 0.0002664567231, 4.789301782e-05,
+    -0.0001613007877, -0.0003452513303, -0.0004910294458, -0.0005895016608, -0.00063582812,
+    -0.0006295877574, -0.0005745427139, -0.0004780824336, -0.0003504113716, -0.0002035611802,
+    -5.031761146e-05, 9.684615812e-05, 0.0002267441551, 0.0003302872635, 0.0004010728617,
+    0.0004357206852, 0.000433943906, 0.0003983666616, 0.0003341192125, 0.0002482580451,
+    0.0001490694838, 4.532108813e-05, -5.447481515e-05, -0.0001427263538, -0.0002133067385,
+    -0.0002619421493, -0.0002864220498, -0.0002866271172, -0.0002643853276, -0.000223180172,
+    -0.0001677455149, -0.000103588547, -3.648529551e-05, 2.800775594e-05, 8.498686668e-05,
+    0.0001305474255, 0.0001620214477, 0.0001780948302, 0.0001788039143, 0.0001654210449,
+    0.0001402473925, 0.0001063376963, 6.718540682e-05, 2.639782057e-05, -1.261069439e-05,
+    -4.688305991e-05, -7.412268069e-05, -9.282345316e-05, -0.0001023218172, -0.0001027731569,
+    -9.506116736e-05, -8.065385983e-05, -6.142332924e-05, -3.944808072e-05, -1.681660063e-05,
+    4.55088897e-06, 2.304864772e-05, 3.748981981e-05, 4.716381891e-05, 5.184614551e-05,
+    5.176438751e-05, 4.752774301e-05, 4.003001361e-05, 3.033749146e-05, 1.957346273e-05,
+    8.810246802e-06, -1.022050591e-06, -9.203328551e-06, -1.52639318e-05, -1.8996802e-05};
+
+static const float fir_diag_250[49] = {
+    -7.261842848e-05, 0.0002650108747, -0.0005928135097, 0.001016986083, -0.001424961025,
+    0.00162958206, -0.00139383316, 0.000483845165, 0.001255231705, -0.003814359227,
+    0.00694725022, -0.01013150616, 0.01258401871, -0.01334123156, 0.01140112357,
+    -0.005908303652, -0.003649893281, 0.01727626717, -0.03436504421, 0.05370139184,
+    -0.07357142112, 0.09197296588, -0.106895758, 0.1166232528, 0.8800096346,
+    0.1166232528, -0.106895758, 0.09197296588, -0.07357142112, 0.05370139184,
+    -0.03436504421, 0.01727626717, -0.003649893281, -0.005908303652, 0.01140112357,
+    -0.01334123156, 0.01258401871, -0.01013150616, 0.00694725022, -0.003814359227,
+    0.001255231705, 0.000483845165, -0.00139383316, 0.00162958206, -0.001424961025,
+    0.001016986083, -0.0005928135097, 0.0002650108747, -7.261842848e-05};
+
+static const float fir_diag_500[65] = {
+    -5.446084748e-05, 0.0002477547196, -0.0002249585869, -0.0002351488131, 0.0007626979148,
+    -0.0005491202945, -0.0006459907902, 0.001719913074, -0.00104531779, -0.001446388343,
+    0.003311551933, -0.001718710253, -0.002860613214, 0.005776060176, -0.002546590622,
+    -0.005209243869, 0.009437498691, -0.003476653297, -0.008991674836, 0.01482404897,
+    -0.004430985782, -0.01512668311, 0.0230297058, -0.005315622875, -0.02577237584,
+    0.03703445183, -0.006034215475, -0.04815451692, 0.06897595793, -0.006503329467,
+    -0.1329428229, 0.278180189, 0.6599711878, 0.278180189, -0.1329428229,
+    -0.006503329467, 0.06897595793, -0.04815451692, -0.006034215475, 0.03703445183,
+    -0.02577237584, -0.005315622875, 0.0230297058, -0.01512668311, -0.004430985782,
+    0.01482404897, -0.008991674836, -0.003476653297, 0.009437498691, -0.005209243869,
+    -0.002546590622, 0.005776060176, -0.002860613214, -0.001718710253, 0.003311551933,
+    -0.001446388343, -0.00104531779, 0.001719913074, -0.0006459907902, -0.0005491202945,
+    0.0007626979148, -0.0002351488131, -0.0002249585869, 0.0002477547196, -5.446084748e-05};
+
+static const float fir_diag_1000[129] = {
+    -2.722877538e-05, 5.983034644e-05, 0.000123869861, 6.195095136e-05, -0.0001124724846,
+    -0.0002302489618, -0.0001175672893, 0.0001833864871, 0.0003813258729, 0.0002015616419,
+    -0.0002745435271, -0.0005874126202, -0.000322975843, 0.0003873741679, 0.0008599044806,
+    0.0004925885523, -0.0005226272564, -0.001211357168, -0.0007231503938, 0.0006802507621,
+    0.001655675736, 0.001029725359, -0.0008593031066, -0.002208492652, -0.001430220025,
+    0.001057902278, 0.002887855265, 0.001946234862, -0.001273218234, -0.003715417159,
+    -0.002604464267, 0.001501511883, 0.004718463702, 0.003439042501, -0.001738221421,
+    -0.005933364016, -0.004495565268, 0.00197809409, 0.007411575807, 0.005838206408,
+    -0.002215358779, -0.009230492311, -0.007562883717, 0.002443932369, 0.01151415587,
+    0.009823142414, -0.002657650551, -0.01447594647, -0.01288540787, 0.002850512173,
+    0.018516105, 0.01726097893, -0.003016925101, -0.02447864591, -0.02407580098,
+    0.003151941137, 0.03448589128, 0.03639116865, -0.003251467898, -0.05577640955,
+    -0.06646738769, 0.003312446559, 0.1390816749, 0.2737711377, 0.3299656186,
+    0.2737711377, 0.1390816749, 0.003312446559, -0.06646738769, -0.05577640955,
+    -0.003251467898, 0.03639116865, 0.03448589128, 0.003151941137, -0.02407580098,
+    -0.02447864591, -0.003016925101, 0.01726097893, 0.018516105, 0.002850512173,
+    -0.01288540787, -0.01447594647, -0.002657650551, 0.009823142414, 0.01151415587,
+    0.002443932369, -0.007562883717, -0.009230492311, -0.002215358779, 0.005838206408,
+    0.007411575807, 0.00197809409, -0.004495565268, -0.005933364016, -0.001738221421,
+    0.003439042501, 0.004718463702, 0.001501511883, -0.002604464267, -0.003715417159,
+    -0.001273218234, 0.001946234862, 0.002887855265, 0.001057902278, -0.001430220025,
+    -0.002208492652, -0.0008593031066, 0.001029725359, 0.001655675736, 0.0006802507621,
+    -0.0007231503938, -0.001211357168, -0.0005226272564, 0.0004925885523, 0.0008599044806,
+    0.0003873741679, -0.000322975843, -0.0005874126202, -0.0002745435271, 0.0002015616419,
+    0.0003813258729, 0.0001833864871, -0.0001175672893, -0.0002302489618, -0.0001124724846,
+    6.195095136e-05, 0.000123869861, 5.983034644e-05, -2.722877538e-05};
+
+static const float fir_lowlat_250[11] = {
+    -3.226879092e-18, -0.03116126536, -0.03935530308, 0.07733225646, 0.2911700317,
+    0.4040285606, 0.2911700317, 0.07733225646, -0.03935530308, -0.03116126536,
+    -3.226879092e-18};
+
+static const float fir_lowlat_500[21] = {
+    0.003888220491, -0.0006809244473, -0.01126166104, -0.02364334986, -0.02838481599,
+    -0.01450523714, 0.02431795975, 0.08438513967, 0.1509973096, 0.2033128179,
+    0.2231490823, 0.2033128179, 0.1509973096, 0.08438513967, 0.02431795975,
+    -0.01450523714, -0.02838481599, -0.02364334986, -0.01126166104, -0.0006809244473,
+    0.003888220491};
+
+static const float fir_lowlat_1000[41] = {
+    0.001948262121, 0.001198951705, -0.0003411893207, -0.002677465354, -0.00564285582,
+    -0.008878903721, -0.01184692151, -0.01387274416, -0.01422271755, -0.01220285042,
+    -0.00726810739, 0.000874359992, 0.01218494681, 0.02624910017, 0.04228267703,
+    0.05918851567, 0.07565989103, 0.09031909963, 0.1018735081, 0.1092680321,
+    0.1118128217, 0.1092680321, 0.1018735081, 0.09031909963, 0.07565989103,
+    0.05918851567, 0.04228267703, 0.02624910017, 0.01218494681, 0.000874359992,
+    -0.00726810739, -0.01220285042, -0.01422271755, -0.01387274416, -0.01184692151,
+    -0.008878903721, -0.00564285582, -0.002677465354, -0.0003411893207, 0.001198951705,
+    0.001948262121};
+
+static const float fir_minphase_250[97] = {
+    0.002890482769, 0.01709503883, 0.05531769977, 0.124860176, 0.2132056384,
+    0.282038307, 0.282887506, 0.1917346095, 0.03818018026, -0.1007345864,
+    -0.1483463853, -0.08607010677, 0.02794602979, 0.1015211806, 0.08171531832,
+    -0.003587506599, -0.07381780867, -0.06920534615, -0.002505923928, 0.05816447667,
+    0.05688556658, 0.001609684564, -0.04880844913, -0.04591759697, 0.001833840327,
+    0.04246238625, 0.03614697046, -0.005875566914, -0.03735509998, -0.02734893072,
+    0.00955356255, 0.03258354953, 0.01944868907, -0.01236128249, -0.02776019054,
+    -0.01250146564, 0.01405431118, 0.02281421959, 0.00662587283, -0.01457682937,
+    -0.01786520565, -0.001934896219, 0.01402156371, 0.01312731586, -0.00151331936,
+    -0.01259236564, -0.008838008842, 0.003744113189, 0.01056580502, 0.005200923261,
+    -0.004872476559, -0.008238016628, -0.002332150073, 0.005120410378, 0.00594339022,
+    0.0003440212694, -0.004643091473, -0.003818156365, 0.0009055060052, 0.003776108773,
+    0.002068806176, -0.001517038708, -0.002765526417, -0.0007908488342, 0.001632277033,
+    0.001790789873, -2.196429004e-05, -0.00142393571, -0.0009745500721, 0.0004374485511,
+    0.001056590974, 0.0003794113809, -0.0005578604908, -0.000662324042, -1.179981014e-05,
+    0.0004941183427, 0.0003274475454, -0.0001614727438, -0.0003452589595, -9.444744384e-05,
+    0.0001964497376, 0.0001866991235, -3.31571115e-05, -0.00015388184, -6.226824489e-05,
+    7.607850345e-05, 8.459960386e-05, -1.195079628e-05, -6.62216126e-05, -2.049184958e-05,
+    4.099935019e-05, 2.815096163e-05, -2.665525503e-05, -2.360836921e-05, 3.295913627e-05,
+    -1.343405697e-05, 2.178286976e-06};
+
+static const float fir_minphase_500[193] = {
+    0.0002624173687, 0.001112093071, 0.00312351126, 0.007054682961, 0.01376106511,
+    0.024022725, 0.03830607586, 0.05650222598, 0.07770638053, 0.1001123991,
+    0.1210876646, 0.1374633919, 0.1460274006, 0.1441500187, 0.130423703,
+    0.1051680912, 0.07065632975, 0.03096125499, -0.008602971669, -0.04237293105,
+    -0.06540107036, -0.07447035006, -0.06882368351, -0.05041630099, -0.02359847532,
+    0.005736694004, 0.03137420853, 0.04810069951, 0.05282579319, 0.04523199537,
+    0.02778877518, 0.005117659909, -0.01714494529, -0.03371335295, -0.04091213609,
+    -0.03751824348, -0.02497786459, -0.00695008319, 0.0116961687, 0.02616461227,
+    0.03295796995, 0.03073255579, 0.02056388601, 0.005561209458, -0.01003366051,
+    -0.02202549922, -0.02738629076, -0.02502140792, -0.01598292596, -0.003090014761,
+    0.009919830916, 0.01945892631, 0.02307348156, 0.02007301361, 0.01164254783,
+    0.0004257130378, -0.01028384914, -0.01749948761, -0.01937025627, -0.0156513343,
+    -0.007697047246, 0.002001697362, 0.01058395991, 0.01565569782, 0.0159542002,
+    0.01165429252, 0.004246323988, -0.003961363561, -0.01055242671, -0.01370904845,
+    -0.01270915173, -0.00807900958, -0.001373346965, 0.005334115854, 0.01008556804,
+    0.01160652588, 0.009642277699, 0.004975949685, -0.0008607022397, -0.006081749264,
+    -0.009188908584, -0.009397422567, -0.006826325195, -0.002409620709, 0.002430188838,
+    0.006234311647, 0.00794348137, 0.007188432011, 0.004356482416, 0.0004276907149,
+    -0.003355987892, -0.005878934461, -0.006477240201, -0.005107309092, -0.002316989895,
+    0.0009592036762, 0.003707414543, 0.005144670213, 0.004938048522, 0.003272679312,
+    0.00075843014, -0.001785154353, -0.003591802506, -0.004176059978, -0.003458754993,
+    -0.001759713138, 0.0003300196951, 0.002148891221, 0.003171178118, 0.003155682648,
+    0.002195593107, 0.0006627511835, -0.0009291319964, -0.002093344262, -0.002516386442,
+    -0.002138546495, -0.001149719687, 9.107739093e-05, 0.001181212507, 0.001802267104,
+    0.001810275742, 0.001263664691, 0.0003859332667, -0.0005193023657, -0.001170100442,
+    -0.001391574222, -0.001159680596, -0.0005936269546, 9.536627567e-05, 0.0006799483556,
+    0.0009889410441, 0.0009555946727, 0.0006274989137, 0.0001397611415, -0.0003367985128,
+    -0.0006534182357, -0.0007281382664, -0.0005646501292, -0.0002418740688, 0.0001194549809,
+    0.0004000397086, 0.0005200396761, 0.0004601589058, 0.0002609350374, 2.862819258e-06,
+    -0.0002241720856, -0.0003510255029, -0.0003492111683, -0.0002353101298, -5.958229503e-05,
+    0.0001120119904, 0.0002251738132, 0.000250603394, 0.0001909256428, 7.661455889e-05,
+    -4.741848593e-05, -0.0001388405745, -0.0001718458049, -0.000143491707, -7.154117634e-05,
+    1.413562011e-05, 8.300756555e-05, 0.0001141792551, 0.0001022464052, 5.721783267e-05,
+    -8.131709439e-07, -4.991429652e-05, -7.432267656e-05, -6.921660189e-05, -4.073729477e-05,
+    -2.258453123e-06, 3.113283262e-05, 4.838763058e-05, 4.555732572e-05, 2.644178422e-05,
+    1.903944968e-07, -2.242323096e-05, -3.314043523e-05, -2.915258092e-05, -1.372042843e-05,
+    5.552717282e-06, 1.99927288e-05, 2.349452224e-05, 1.517258811e-05, -1.563133554e-07,
+    -1.403043942e-05, -1.830570175e-05, -9.764769834e-06, 6.371168445e-06, 1.663676551e-05,
+    6.896062625e-06, -1.773515288e-05, 5.722159165e-06};
+
+static const float fir_minphase_1000[385] = {
+    5.27981101e-05, 0.0001466925068, 0.0003160162977, 0.0005936734035, 0.001019342544,
+    0.001638864875, 0.002503079167, 0.003665990074, 0.005182279917, 0.007104189853,
+    0.009477867386, 0.01233930745, 0.01571009953, 0.01959322608, 0.02396921697,
+    0.02879292569, 0.0339912441, 0.03946206389, 0.04507472633, 0.05067212172,
+    0.05607457159, 0.06108547149, 0.06549858157, 0.06910676049, 0.07171177518,
+    0.07313473619, 0.07322660713, 0.07187820528, 0.06902906344, 0.06467463346,
+    0.05887123348, 0.05173765203, 0.04345474057, 0.03426040713, 0.0244422543,
+    0.01432674844, 0.004265737495, -0.005379135573, -0.01425339314, -0.02202715489,
+    -0.02841208993, -0.03317689408, -0.03616035992, -0.03728118958, -0.03654385518,
+    -0.03403996951, -0.02994503679, -0.02451054399, -0.01805168944, -0.01093135589,
+    -0.003541215734, 0.003719124005, 0.01046369014, 0.0163411498, 0.02105404263,
+    0.02437506066, 0.02615937095, 0.02635218345, 0.02499106145, 0.02220273692,
+    0.01819466313, 0.01324186025, 0.007669530866, 0.0018329818, -0.003904483161,
+    -0.009193745795, -0.01372112993, -0.01722726442, -0.01952235901, -0.02049695705,
+    -0.02012747784, -0.01847623023, -0.01568592598, -0.01196909141, -0.007593100097,
+    -0.002861835066, 0.001904882751, 0.006392473963, 0.01031216748, 0.01341962108,
+    0.01553035327, 0.01653077288, 0.01638437101, 0.01513264515, 0.01289071473,
+    0.009838020951, 0.006204802216, 0.00225533979, -0.001730828209, -0.00547837743,
+    -0.008735071578, -0.01128871702, -0.01298095054, -0.01371714977, -0.01347159711,
+    -0.01228786916, -0.01027422704, -0.007594608099, -0.004455859307, -0.00109216382,
+    0.002252148637, 0.005340163681, 0.00795904849, 0.00993464665, 0.0111429968,
+    0.0115180252, 0.0110549547, 0.009809545989, 0.007892560574, 0.005460261602,
+    0.002702085301, -0.0001735738421, -0.002955048854, -0.00544286652, -0.007463962374,
+    -0.008883667869, -0.009614617981, -0.00962200324, -0.008924854336, -0.007593355991,
+    -0.005742430856, -0.003522201957, -0.001106101845, 0.001322531806, 0.003584194119,
+    0.005516435556, 0.006985417692, 0.007895152954, 0.008193672757, 0.007875764403,
+    0.006982179568, 0.005595425449, 0.003832531232, 0.001835402224, -0.0002404491296,
+    -0.002237881951, -0.004009824462, -0.005429710919, -0.006400355977, -0.006863530388,
+    -0.006798420027, -0.006225151092, -0.005201495394, -0.003817502251, -0.002187850262,
+    -0.0004425158622, 0.00128346353, 0.002860349648, 0.00417338799, 0.005131104189,
+    0.005671595967, 0.005766420859, 0.005421806219, 0.004677169567, 0.003601214776,
+    0.002285792697, 0.0008382673275, -0.0006271740825, -0.001998426587, -0.003173967785,
+    -0.004070323158, -0.004627916253, -0.004814908375, -0.004628791336, -0.004095681188,
+    -0.003267443895, -0.002216944254, -0.001031814268, 0.000192815699, 0.001361888314,
+    0.002387480051, 0.003195672709, 0.003731634103, 0.003963250209, 0.003882898575,
+    0.003507247628, 0.002875193778, 0.002044129405, 0.001084898815, 7.58661683e-05,
+    -0.0009033998676, -0.001778338782, -0.002485007675, -0.00297470933, -0.003217279989,
+    -0.003202718932, -0.002941381811, -0.002462382256, -0.001810715925, -0.001043211004,
+    -0.0002236618611, 0.0005823964537, 0.001312865345, 0.001913807434, 0.00234336811,
+    0.002574615673, 0.002597111563, 0.002417119791, 0.002056470291, 0.001550273764,
+    0.0009437040458, 0.0002879916426, -0.0003637210526, -0.0009606862933, -0.001458433792,
+    -0.001822005502, -0.002028338173, -0.002067609194, -0.001943499806, -0.001672375113,
+    -0.001281496231, -0.0008064304419, -0.0002879144828, 0.0002315738471, 0.0007112021161,
+    0.001114915496, 0.00141433291, 0.001590312287, 0.001634329891, 0.001548693622,
+    0.001345854449, 0.001046989669, 0.0006799490028, 0.0002767521982, -0.0001291441691,
+    -0.0005055801099, -0.0008242039248, -0.001062561399, -0.001205600595, -0.001246533551,
+    -0.001187010571, -0.001036565947, -0.0008115374345, -0.0005333984703, -0.0002268578965,
+    8.226504361e-05, 0.0003691578048, 0.0006119493647, 0.0007933502526, 0.0009018504072,
+    0.0009324089758, 0.000886582914, 0.0007721001605, 0.0006018949905, 0.0003927003609,
+    0.0001632068014, -6.830843814e-05, -0.0002813136619, -0.0004600753489, -0.0005920166248,
+    -0.0006689249678, -0.0006874848849, -0.0006493043624, -0.0005605321653, -0.0004311209966,
+    -0.0002738139211, -0.0001029529989, 6.677721182e-05, 0.000221561833, 0.0003495567227,
+    0.000441768269, 0.0004926141817, 0.0005002313437, 0.0004663955261, 0.0003962211073,
+    0.0002975226644, 0.0001800388241, 5.452700207e-05, -6.819536359e-05, -0.0001781427503,
+    -0.0002669429949, -0.0003284440236, -0.0003591131216, -0.0003581974654, -0.0003276520124,
+    -0.0002717868257, -0.0001966309034, -0.0001096006109, -1.861279679e-05, 6.837239406e-05,
+    0.0001443255611, 0.0002035386839, 0.00024205595, 0.0002579032942, 0.0002511353569,
+    0.0002237079851, 0.0001791988757, 0.000122409579, 5.888906397e-05, -5.586847894e-06,
+    -6.550794601e-05, -0.0001160654496, -0.0001535635259, -0.0001756189856, -0.0001813321942,
+    -0.0001712318238, -0.0001471895768, -0.0001121606785, -6.984961201e-05, -2.435884436e-05,
+    2.019070954e-05, 6.001777961e-05, 9.199381555e-05, 0.0001138787794, 0.0001244643282,
+    0.0001235860716, 0.0001120607829, 9.162632803e-05, 6.467301937e-05, 3.400155484e-05,
+    2.511710922e-06, -2.698172395e-05, -5.203663557e-05, -7.076605346e-05, -8.196578115e-05,
+    -8.517390672e-05, -8.066224316e-05, -6.93642063e-05, -5.275261056e-05, -3.267363946e-05,
+    -1.116358039e-05, 9.757737718e-06, 2.829052773e-05, 4.291165316e-05, 5.260493013e-05,
+    5.681978866e-05, 5.559127035e-05, 4.943351753e-05, 3.926131249e-05, 2.629780186e-05,
+    1.193553267e-05, -2.403560712e-06, -1.540664092e-05, -2.598462447e-05, -3.335416238e-05,
+    -3.707143335e-05, -3.705765887e-05, -3.359873677e-05, -2.726295963e-05, -1.884923913e-05,
+    -9.298457588e-06, 3.909103379e-07, 9.289672679e-06, 1.659991734e-05, 2.172864407e-05,
+    2.433709957e-05, 2.435950902e-05, 2.198772301e-05, 1.763193253e-05, 1.185932425e-05,
+    5.330233114e-06, -1.268918925e-06, -7.265964223e-06, -1.200795263e-05, -1.521032307e-05,
+    -1.649248441e-05, -1.592353952e-05, -1.366817666e-05, -1.005294288e-05, -5.547321821e-06,
+    -7.01828857e-07, 3.909758965e-06, 7.758025119e-06, 1.041574996e-05, 1.160493635e-05,
+    1.122313929e-05, 9.365104762e-06, 6.31403158e-06, 2.508110816e-06, -1.494673251e-06,
+    -5.092915549e-06, -7.716530268e-06, -8.914165607e-06, -8.426627304e-06, -6.271172922e-06,
+    -2.792350762e-06, 1.328271111e-06, 5.123960359e-06, 7.470458553e-06, 7.328989494e-06,
+    4.139146863e-06, -1.580501289e-06, -7.385654013e-06, -7.760347579e-06, 7.032090308e-06};
+
+#define FIR_DESIGN(m, f, t, fc, c) {FIR_MODE_##m, f, t, ((t) - 1) / 2, fc, c}
+#define FIR_DESIGN_MINPHASE(f, t, d, c) {FIR_MODE_MINPHASE, f, t, d, 45, c}
+
+static const FIR_Design_t fir_bank[] = {
+    FIR_DESIGN(LEGACY, 500, 181, 75, fir_legacy_500),
+    FIR_DESIGN(BYPASS, 0, 1, 0, fir_bypass),
+    FIR_DESIGN(MONITOR, 250, 97, 45, fir_monitor_250),
+    FIR_DESIGN(MONITOR, 500, 193, 45, fir_monitor_500),
+    FIR_DESIGN(MONITOR, 1000, 385, 45, fir_monitor_1000),
+    FIR_DESIGN(DIAG, 250, 49, 110, fir_diag_250),
+    FIR_DESIGN(DIAG, 500, 65, 165, fir_diag_500),
+    FIR_DESIGN(DIAG, 1000, 129, 165, fir_diag_1000),
+    FIR_DESIGN(LOWLAT, 250, 11, 50, fir_lowlat_250),
+    FIR_DESIGN(LOWLAT, 500, 21, 55, fir_lowlat_500),
+    FIR_DESIGN(LOWLAT, 1000, 41, 55, fir_lowlat_1000),
+    FIR_DESIGN_MINPHASE(250, 97, 5, fir_minphase_250),
+    FIR_DESIGN_MINPHASE(500, 193, 10, fir_minphase_500),
+    FIR_DESIGN_MINPHASE(1000, 385, 22, fir_minphase_1000),
+};
+
+#define FIR_BANK_NUM (sizeof(fir_bank) / sizeof(fir_bank[0]))
+
+static const char *const fir_mode_name[FIR_MODE_NUM] = {"legacy", "bypass", "monitor", "diag", "lowlat", "minphase"};
+
+/**
+ * @brief 按模式查找设计，采样率没有完全匹配的设计时取设计采样率最接近的一个，
+ *        此时实际截止频率按 fs/设计采样率 缩放
+ * @return 模式不存在时返回直通
+ */
+const FIR_Design_t *FIR_Bank_Find(uint8_t mode, uint16_t fs)
+{
+    const FIR_Design_t *best = &fir_bank[1];
+    int32_t best_diff = INT32_MAX;
+
+    for (uint16_t i = 0; i < FIR_BANK_NUM; i++)
+    {
+        int32_t diff = abs((int32_t)fir_bank[i].fs - fs);
+
+        if (fir_bank[i].mode != mode)
+            continue;
+        if (fir_bank[i].fs == 0)
+            return &fir_bank[i];
+        if (diff < best_diff)
+        {
+            best = &fir_bank[i];
+            best_diff = diff;
+        }
+    }
+    return best;
+}
+
+const char *FIR_Bank_Name(uint8_t mode)
+{
+    return mode < FIR_MODE_NUM ? fir_mode_name[mode] : "?";
+}
+
+void FIR_Bank_Dump(void)
+{
+    for (uint16_t i = 0; i < FIR_BANK_NUM; i++)
+    {
+        const FIR_Design_t *d = &fir_bank[i];
+
+        printf("FIR %u %s fs=%u taps=%u delay=%u fc=%u\n", d->mode, fir_mode_name[d->mode],
+               d->fs, d->taps, d->delay, d->f_cut);
+    }
+}
@@ -0,0 +1,38 @@
+#ifndef FIR_BANK_H
+#define FIR_BANK_H
+
+#include "stdint.h"
+
+/*
+ * FIR滤波器组：预先设计好的线性相位系数表，按模式和采样率查找
+ * 每个设计带有设计采样率、阶数与群延迟
+ * 这些设计只决定通带上沿，基线漂移(0.5Hz/0.05Hz以下)由 IIR 高通去除，
+ * 在500SPS下用FIR实现亚赫兹的下沿需要数千阶
+ */
+
+/* 滤波模式 */
+#define FIR_MODE_LEGACY 0  // 原MATLAB设计，75Hz低通，181阶
+#define FIR_MODE_BYPASS 1  // 直通
+#define FIR_MODE_MONITOR 2 // 监护，40Hz低通，50/60Hz处衰减60dB以上
+#define FIR_MODE_DIAG 3    // 诊断，150Hz低通
+#define FIR_MODE_LOWLAT 4  // 低延迟，40Hz低通，群延迟约20ms
+#define FIR_MODE_MINPHASE 5 // 最小相位，幅频响应同监护，QRS频段群延迟约20ms，相位非线性
+#define FIR_MODE_NUM 6
+
+#define FIR_MAX_TAPS 385 // 所有设计中的最大阶数，决定共享输入历史的长度
+
+typedef struct
+{
+    uint8_t mode;
+    uint16_t fs;     // 设计采样率，0表示与采样率无关
+    uint16_t taps;   // 阶数
+    uint16_t delay;  // 群延迟，单位样本，线性相位时为 (taps-1)/2，最小相位时为10Hz处的值
+    uint16_t f_cut;  // -6dB截止频率，Hz
+    const float *coeffs;
+} FIR_Design_t;
+
+const FIR_Design_t *FIR_Bank_Find(uint8_t mode, uint16_t fs); // 取该模式下设计采样率最接近fs的设计
+const char *FIR_Bank_Name(uint8_t mode);                      // 模式名称
+void FIR_Bank_Dump(void);                                     // 通过printf列出所有设计
+
+#endif // !FIR_BANK_H
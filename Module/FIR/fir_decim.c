@@ -0,0 +1,147 @@
+#include "fir_decim.h"
+#include "ecg_conf.h"
+#include <math.h>
+#include <string.h>
+
+#define FIR_DECIM_PI 3.14159265358979
+
+/**
+ * @brief 初始化抽取器，按倍数设计Hamming窗低通，截止频率为输出奈奎斯特频率的0.8倍
+ * @param factor: 抽取倍数 1~FIR_DECIM_MAX_FACTOR，超出时限幅
+ */
+void FIR_Decim_Init(FIR_Decim_t *d, uint8_t factor)
+{
+    uint16_t taps;
+    double fc, sum = 0.0;
+    double h[FIR_DECIM_MAX_TAPS];
+
+    if (factor < 1)
+        factor = 1;
+    if (factor > FIR_DECIM_MAX_FACTOR)
+        factor = FIR_DECIM_MAX_FACTOR;
+
+    memset(d, 0, sizeof(FIR_Decim_t));
+    d->factor = factor;
+    d->phase = factor - 1;
+    if (factor == 1)
+        return;
+
+    // 窗函数法设计，归一化到直流增益为1
+    taps = (uint16_t)factor * FIR_DECIM_BRANCH_TAPS;
+    fc = 0.8 * 0.5 / factor;
+    for (uint16_t i = 0; i < taps; i++)
+    {
+        double m = i - (taps - 1) / 2.0;
+        double w = 0.54 - 0.46 * cos(2.0 * FIR_DECIM_PI * i / (taps - 1));
+
+        h[i] = 2.0 * fc * w * (m == 0.0 ? 1.0 : sin(2.0 * FIR_DECIM_PI * fc * m) / (2.0 * FIR_DECIM_PI * fc * m));
+        sum += h[i];
+    }
+
+    // 拆分为多相支路
+    for (uint16_t i = 0; i < taps; i++)
+    {
+        uint16_t k = i % factor;
+        uint16_t n = i / factor;
+        double c = h[i] / sum;
+
+#if ECG_USE_FIXED_POINT
+        d->coeffs_q31[k * FIR_DECIM_BRANCH_TAPS + n] = (int32_t)lround(c * 2147483648.0);
+#else
+        d->coeffs[k * FIR_DECIM_BRANCH_TAPS + n] = (float)c;
+#endif
+    }
+}
+
+#if !ECG_USE_FIXED_POINT
+/**
+ * @brief 输入一个样本，累加所属支路的部分和
+ * @param output: 有输出时写入，抽取后的样本
+ * @return 1:本次产生了一个输出
+ */
+ECG_RAMFUNC(DECIM) uint8_t FIR_Decim_Process(FIR_Decim_t *d, float input, float *output)
+{
+    uint8_t k = d->phase;
+    const float *c = &d->coeffs[k * FIR_DECIM_BRANCH_TAPS];
+    const float *x;
+
+    if (d->factor == 1)
+    {
+        *output = input;
+        return 1;
+    }
+
+    // 每个支路每M个输入前进一格，M个支路共用同一写入位置，在最后一个支路处移动
+    d->state[k][d->pos] = input;
+    d->state[k][d->pos + FIR_DECIM_BRANCH_TAPS] = input;
+    x = &d->state[k][d->pos];
+    for (uint8_t n = 0; n < FIR_DECIM_BRANCH_TAPS; n++)
+    {
+        d->acc += c[n] * x[n];
+    }
+
+    if (k > 0)
+    {
+        d->phase = k - 1;
+        return 0;
+    }
+
+    *output = d->acc;
+    d->acc = 0.0f;
+    d->phase = d->factor - 1;
+    d->pos = d->pos == 0 ? FIR_DECIM_BRANCH_TAPS - 1 : d->pos - 1;
+    return 1;
+}
+#else
+/**
+ * @brief Q31版本，64位累加，输出饱和到Q31范围
+ */
+ECG_RAMFUNC(DECIM) uint8_t FIR_Decim_ProcessQ31(FIR_Decim_t *d, int32_t input, int32_t *output)
+{
+    uint8_t k = d->phase;
+    const int32_t *c = &d->coeffs_q31[k * FIR_DECIM_BRANCH_TAPS];
+    const int32_t *x;
+    int64_t acc;
+
+    if (d->factor == 1)
+    {
+        *output = input;
+        return 1;
+    }
+
+    d->state_q31[k][d->pos] = input;
+    d->state_q31[k][d->pos + FIR_DECIM_BRANCH_TAPS] = input;
+    x = &d->state_q31[k][d->pos];
+    for (uint8_t n = 0; n < FIR_DECIM_BRANCH_TAPS; n++)
+    {
+        d->acc_q31 += (int64_t)c[n] * x[n];
+    }
+
+    if (k > 0)
+    {
+        d->phase = k - 1;
+        return 0;
+    }
+
+    acc = d->acc_q31 >> 31;
+    if (acc > INT32_MAX)
+        acc = INT32_MAX;
+    else if (acc < INT32_MIN)
+        acc = INT32_MIN;
+    *output = (int32_t)acc;
+    d->acc_q31 = 0;
+    d->phase = d->factor - 1;
+    d->pos = d->pos == 0 ? FIR_DECIM_BRANCH_TAPS - 1 : d->pos - 1;
+    return 1;
+}
+#endif
+
+/**
+ * @brief 线性相位低通的群延迟
+ */
+uint16_t FIR_Decim_Delay(const FIR_Decim_t *d)
+{
+    if (d->factor == 1)
+        return 0;
+    return ((uint16_t)d->factor * FIR_DECIM_BRANCH_TAPS - 1) / 2;
+}
@@ -0,0 +1,46 @@
+#ifndef FIR_DECIM_H
+#define FIR_DECIM_H
+
+#include "stdint.h"
+#include "ecg_conf.h"
+
+/*
+ * 多相抽取FIR：低通系数按抽取倍数M拆成M个子滤波器，
+ * 每个输入样本只与所属支路的 taps/M 个系数相乘并累加，第M个样本时输出一次
+ * 只计算保留下来的输出，且计算量均摊到每个输入样本上
+ * 不依赖HAL，可在主机端编译
+ * 系数与延迟线只保留当前信号链的一种：ECG_USE_FIXED_POINT 为1时只有Q31版本，否则只有浮点版本
+ */
+
+#define FIR_DECIM_MAX_FACTOR 4   // 最大抽取倍数
+#define FIR_DECIM_BRANCH_TAPS 12 // 每个支路的系数个数，总阶数为 12*M
+#define FIR_DECIM_MAX_TAPS (FIR_DECIM_MAX_FACTOR * FIR_DECIM_BRANCH_TAPS)
+
+typedef struct
+{
+    uint8_t factor; // 抽取倍数M，1时直通
+    uint8_t phase;  // 下一个输入样本所属的支路，M-1递减到0
+    uint16_t pos;   // 各支路延迟线的写入位置
+
+    /* 支路k的系数为 h(n*M+k)，n=0..BRANCH_TAPS-1；
+     * 各支路的延迟线为双倍长度，卷积时连续读取 */
+#if ECG_USE_FIXED_POINT
+    int32_t coeffs_q31[FIR_DECIM_MAX_TAPS];
+    int32_t state_q31[FIR_DECIM_MAX_FACTOR][FIR_DECIM_BRANCH_TAPS * 2];
+    int64_t acc_q31; // 当前输出的部分和
+#else
+    float coeffs[FIR_DECIM_MAX_TAPS];
+    float state[FIR_DECIM_MAX_FACTOR][FIR_DECIM_BRANCH_TAPS * 2];
+    float acc; // 当前输出的部分和
+#endif
+} FIR_Decim_t;
+
+void FIR_Decim_Init(FIR_Decim_t *d, uint8_t factor);                      // 设计抗混叠低通并清空状态
+#if ECG_USE_FIXED_POINT
+uint8_t FIR_Decim_ProcessQ31(FIR_Decim_t *d, int32_t input, int32_t *output); // 输入一个样本，有输出时返回1
+#else
+uint8_t FIR_Decim_Process(FIR_Decim_t *d, float input, float *output);     // 输入一个样本，有输出时返回1
+#endif
+uint16_t FIR_Decim_Delay(const FIR_Decim_t *d);                           // 群延迟，单位为输入样本
+
+#endif // !FIR_DECIM_H
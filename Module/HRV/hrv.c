@@ -0,0 +1,226 @@
+#include "hrv.h"
+#include <math.h>
+#include <string.h>
+
+#define HRV_PI 3.14159265f
+
+void HRV_Init(HRV_t *hrv, uint16_t window_s)
+{
+    memset(hrv, 0, sizeof(HRV_t));
+    if (window_s == 0 || window_s > HRV_WINDOW_MAX_S)
+        window_s = HRV_WINDOW_MAX_S;
+    hrv->window_ms = window_s * 1000u;
+}
+
+/**
+ * @brief 移出最早的心拍，其逐差一并移出
+ */
+static void hrv_pop(HRV_t *hrv)
+{
+    const HRV_Beat_t *b = &hrv->beat[hrv->head];
+
+    hrv->sum -= b->rr;
+    hrv->sum2 -= (uint32_t)b->rr * b->rr;
+    if (b->diff != HRV_NO_DIFF)
+    {
+        hrv->dsum2 -= (uint32_t)((int32_t)b->diff * b->diff);
+        hrv->dcount--;
+        if (b->diff > 50 || b->diff < -50)
+            hrv->nn50--;
+    }
+    hrv->head = hrv->head + 1 >= HRV_MAX_BEATS ? 0 : hrv->head + 1;
+    hrv->count--;
+}
+
+/**
+ * @brief 输入一个R峰时刻
+ * @param t_ms: R峰时刻，ms，允许回绕
+ * @return 1:RR间期在正常范围内，已计入窗口
+ */
+uint8_t HRV_AddBeat(HRV_t *hrv, uint32_t t_ms)
+{
+    uint32_t rr = t_ms - hrv->last_t;
+    uint8_t contiguous = hrv->last_nn;
+    HRV_Beat_t *b;
+
+    if (!hrv->has_last)
+    {
+        hrv->has_last = 1;
+        hrv->last_t = t_ms;
+        return 0;
+    }
+    hrv->last_t = t_ms;
+
+    // 移出超出窗口的心拍
+    while (hrv->count > 0 && t_ms - hrv->beat[hrv->head].t > hrv->window_ms)
+        hrv_pop(hrv);
+
+    hrv->last_nn = 0;
+    if (rr < HRV_RR_MIN || rr > HRV_RR_MAX ||
+        (hrv->count > 0 && (rr * hrv->count * 100u > hrv->sum * (100u + HRV_RR_DEV) ||
+                            rr * hrv->count * 100u < hrv->sum * (100u - HRV_RR_DEV))))
+    {
+        hrv->rejected++;
+        // 连续多个心拍都偏离均值，说明心率确实变了或窗口中是误检，清空窗口重新开始
+        if (++hrv->reject_run >= HRV_REJECT_RESET)
+        {
+            hrv->count = 0;
+            hrv->sum = 0;
+            hrv->sum2 = 0;
+            hrv->dsum2 = 0;
+            hrv->dcount = 0;
+            hrv->nn50 = 0;
+            hrv->ls_k = 0;
+        }
+        return 0;
+    }
+
+    if (hrv->count >= HRV_MAX_BEATS)
+        hrv_pop(hrv);
+    b = &hrv->beat[(hrv->head + hrv->count) % HRV_MAX_BEATS];
+    b->t = t_ms;
+    b->rr = (uint16_t)rr;
+    b->diff = HRV_NO_DIFF;
+    if (contiguous && hrv->count > 0)
+    {
+        const HRV_Beat_t *prev = &hrv->beat[(hrv->head + hrv->count - 1) % HRV_MAX_BEATS];
+        int32_t d = (int32_t)rr - prev->rr;
+
+        b->diff = (int16_t)d;
+        hrv->dsum2 += (uint32_t)(d * d);
+        hrv->dcount++;
+        if (d > 50 || d < -50)
+            hrv->nn50++;
+    }
+    hrv->sum += rr;
+    hrv->sum2 += rr * rr;
+    hrv->count++;
+    hrv->last_nn = 1;
+    hrv->reject_run = 0;
+    return 1;
+}
+
+void HRV_GetTime(const HRV_t *hrv, HRV_Time_t *out)
+{
+    memset(out, 0, sizeof(HRV_Time_t));
+    out->beats = hrv->count;
+    if (hrv->count > 0)
+        out->mean_rr = (float)hrv->sum / hrv->count;
+    if (hrv->count > 1)
+    {
+        // n*Σx² - (Σx)² 为整数，避免大数相减的舍入误差
+        uint64_t s = (uint64_t)hrv->sum * hrv->sum;
+        uint64_t v = hrv->sum2 * hrv->count - s;
+
+        out->sdnn = sqrtf((float)v / ((float)hrv->count * (hrv->count - 1)));
+    }
+    if (hrv->dcount > 0)
+    {
+        out->rmssd = sqrtf((float)hrv->dsum2 / hrv->dcount);
+        out->pnn50 = 100.0f * hrv->nn50 / hrv->dcount;
+    }
+}
+
+/**
+ * @brief 空闲时调用：到了更新时间且数据足够时开始一张新谱，之后每次处理一个频点的一部分心拍
+ *        Lomb-Scargle：对每个频率 ω，先由 Σcos2ωt、Σsin2ωt 求 τ，
+ *        P = [(Σy·cos ω(t-τ))²/Σcos²ω(t-τ) + (Σy·sin ω(t-τ))²/Σsin²ω(t-τ)] / 2，
+ *        这里把各和式展开为 c=cos ωt、s=sin ωt 的和，一遍循环、每点一次sin/cos
+ *        均匀采样时P即为 |X|²/N，频点间隔为 1/T 时按Parseval，单边的 2P/N 之和即为方差，
+ *        所以每个频点的 2P/N 累加为频带功率，ms²
+ * @return 1:一张谱完成，lf/hf已更新
+ */
+uint8_t HRV_Step(HRV_t *hrv)
+{
+    float f, wtau, ct, st, yc, ys, cc, ss, p;
+    uint16_t todo;
+
+    if (hrv->ls_k == 0)
+    {
+        const HRV_Beat_t *newest;
+        uint32_t span;
+
+        // 先检查心拍数，count为0时 head+count-1 为负，不能用来取地址
+        if (hrv->count < 2)
+            return 0;
+        newest = &hrv->beat[(hrv->head + hrv->count - 1) % HRV_MAX_BEATS];
+        span = newest->t - hrv->beat[hrv->head].t;
+        if (span < HRV_SPECTRUM_MIN_S * 1000u ||
+            (hrv->ls_started && newest->t - hrv->ls_start < HRV_SPECTRUM_PERIOD))
+            return 0;
+        hrv->ls_started = 1;
+        hrv->ls_start = newest->t;
+        hrv->ls_df = 1000.0f / span;
+        hrv->ls_num = (uint16_t)((HRV_HF_HI - HRV_LF_LO) / hrv->ls_df) + 1;
+        hrv->ls_lf = 0.0f;
+        hrv->ls_hf = 0.0f;
+        hrv->ls_k = 1;
+        hrv->ls_n = 0;
+    }
+
+    f = HRV_LF_LO + (hrv->ls_k - 1) * hrv->ls_df;
+    if (hrv->ls_n == 0)
+    {
+        // 新频点：固定本频点使用的心拍范围、均值与时间零点，之后新加入的心拍不影响
+        if (hrv->count < 2)
+        {
+            hrv->ls_k = 0;
+            return 0;
+        }
+        hrv->ls_pos = hrv->head;
+        hrv->ls_n = hrv->count;
+        hrv->ls_left = hrv->count;
+        hrv->ls_tref = hrv->beat[(hrv->head + hrv->count - 1) % HRV_MAX_BEATS].t;
+        hrv->ls_mean = (float)hrv->sum / hrv->count;
+        hrv->ls_w = 2.0f * HRV_PI * f;
+        hrv->syc = hrv->sys = hrv->scc = hrv->sss = hrv->scs = 0.0f;
+    }
+
+    todo = hrv->ls_left < HRV_STEP_POINTS ? hrv->ls_left : HRV_STEP_POINTS;
+    for (uint16_t i = 0; i < todo; i++)
+    {
+        const HRV_Beat_t *b = &hrv->beat[hrv->ls_pos];
+        float t = (int32_t)(b->t - hrv->ls_tref) * 0.001f; // 相对时间零点，s，不受回绕影响
+        float y = b->rr - hrv->ls_mean;
+        float c = cosf(hrv->ls_w * t), s = sinf(hrv->ls_w * t);
+
+        hrv->syc += y * c;
+        hrv->sys += y * s;
+        hrv->scc += c * c;
+        hrv->sss += s * s;
+        hrv->scs += c * s;
+        hrv->ls_pos = hrv->ls_pos + 1 >= HRV_MAX_BEATS ? 0 : hrv->ls_pos + 1;
+    }
+    hrv->ls_left -= todo;
+    if (hrv->ls_left > 0)
+        return 0;
+
+    // tan 2ωτ = Σsin2ωt / Σcos2ωt
+    wtau = 0.5f * atan2f(2.0f * hrv->scs, hrv->scc - hrv->sss);
+    ct = cosf(wtau);
+    st = sinf(wtau);
+    yc = ct * hrv->syc + st * hrv->sys;
+    ys = ct * hrv->sys - st * hrv->syc;
+    cc = ct * ct * hrv->scc + 2.0f * ct * st * hrv->scs + st * st * hrv->sss;
+    ss = st * st * hrv->scc - 2.0f * ct * st * hrv->scs + ct * ct * hrv->sss;
+    p = 0.0f;
+    if (cc > 0.0f)
+        p += yc * yc / cc;
+    if (ss > 0.0f)
+        p += ys * ys / ss;
+    p *= 0.5f * 2.0f / hrv->ls_n;
+
+    if (f < HRV_LF_HI)
+        hrv->ls_lf += p;
+    else
+        hrv->ls_hf += p;
+    hrv->ls_n = 0;
+
+    if (++hrv->ls_k <= hrv->ls_num)
+        return 0;
+    hrv->ls_k = 0;
+    hrv->lf = hrv->ls_lf;
+    hrv->hf = hrv->ls_hf;
+    hrv->spectra++;
+    return 1;
+}
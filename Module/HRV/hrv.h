@@ -0,0 +1,91 @@
+#ifndef HRV_H
+#define HRV_H
+
+#include "stdint.h"
+
+/*
+ * 心率变异性：输入R峰时刻，维护最近window_ms内的正常RR间期(NN)
+ * 时域：SDNN、RMSSD、pNN50，窗口内的和与平方和用整数累加，每个心拍加入/移出都是O(1)，没有累积误差
+ * 频域：Lomb-Scargle周期图，不需要重采样；由空闲时间调度，每次 HRV_Step 处理一个频点的
+ *       最多 HRV_STEP_POINTS 个心拍，单次耗时有界；计算过程中窗口仍在滑动，
+ *       一张谱内各频点对应的窗口最多相差几个心拍
+ * 内存固定为 HRV_MAX_BEATS 个心拍，覆盖5分钟、平均200bpm
+ * 不依赖HAL，可在主机端编译
+ */
+
+#define HRV_MAX_BEATS 1000
+#define HRV_WINDOW_MAX_S 300 // 窗口最长5分钟
+#define HRV_RR_MIN 300       // 正常RR间期范围，ms
+#define HRV_RR_MAX 2000
+#define HRV_RR_DEV 30        // 与窗口均值偏差超过30%的RR视为异位或误检，不计入
+#define HRV_REJECT_RESET 8   // 连续未计入的心拍数达到此值时清空窗口
+#define HRV_NO_DIFF INT16_MIN // 与上一个心拍不连续，没有逐差
+
+/* 频域频带，Hz */
+#define HRV_LF_LO 0.04f
+#define HRV_LF_HI 0.15f
+#define HRV_HF_HI 0.40f
+#define HRV_SPECTRUM_MIN_S 60    // 窗口内数据不足60s时不计算频域
+#define HRV_SPECTRUM_PERIOD 30000 // 频域更新间隔，ms
+#define HRV_STEP_POINTS 64       // 每次 HRV_Step 处理的心拍数
+
+typedef struct
+{
+    uint32_t t;  // R峰时刻，ms
+    uint16_t rr; // 与前一个R峰的间期，ms
+    int16_t diff; // 与前一个NN的差，ms
+} HRV_Beat_t;
+
+typedef struct
+{
+    float sdnn;  // ms
+    float rmssd; // ms
+    float pnn50; // %
+    float mean_rr; // ms
+    uint16_t beats;
+} HRV_Time_t;
+
+typedef struct
+{
+    HRV_Beat_t beat[HRV_MAX_BEATS];
+    uint16_t head;  // 最早的心拍
+    uint16_t count;
+    uint32_t window_ms;
+
+    uint32_t last_t;  // 上一个R峰时刻，包括未计入的心拍
+    uint8_t has_last;
+    uint8_t last_nn;  // 上一个心拍计入了窗口
+    uint32_t rejected; // 未计入的心拍数
+    uint8_t reject_run; // 连续未计入的心拍数
+
+    /* 窗口内的累加量 */
+    uint32_t sum;   // ΣNN
+    uint64_t sum2;  // ΣNN²
+    uint64_t dsum2; // Σdiff²
+    uint16_t dcount;
+    uint16_t nn50;  // |diff|>50ms 的个数
+
+    /* Lomb-Scargle */
+    uint16_t ls_k;     // 正在计算的频点，从1开始，0时空闲
+    uint16_t ls_num;   // 本张谱的频点数
+    uint16_t ls_pos;   // 当前频点下一个要处理的心拍位置
+    uint16_t ls_n;     // 当前频点的心拍数，0时尚未开始
+    uint16_t ls_left;  // 当前频点剩余的心拍数
+    uint32_t ls_tref;  // 当前频点的时间零点，即开始时最新的R峰
+    float ls_mean;
+    float ls_w;
+    float syc, sys, scc, sss, scs; // 当前频点的累加量
+    float ls_df;       // 频点间隔，Hz，等于窗口时长的倒数
+    float ls_lf, ls_hf; // 本张谱已累加的频带功率
+    uint32_t ls_start; // 上一张谱开始时的R峰时刻
+    uint8_t ls_started;
+    float lf, hf;      // 最近一张完整谱的频带功率，ms²
+    uint32_t spectra;  // 已完成的谱数
+} HRV_t;
+
+void HRV_Init(HRV_t *hrv, uint16_t window_s);             // 初始化，window_s不超过HRV_WINDOW_MAX_S
+uint8_t HRV_AddBeat(HRV_t *hrv, uint32_t t_ms);           // 输入R峰时刻，RR计入窗口时返回1
+void HRV_GetTime(const HRV_t *hrv, HRV_Time_t *out);      // 时域指标，O(1)
+uint8_t HRV_Step(HRV_t *hrv);                             // 空闲时调用，推进频域计算，一张谱完成时返回1
+
+#endif // !HRV_H
@@ -0,0 +1,218 @@
+#include "iir.h"
+#include <math.h>
+#include <string.h>
+
+#define IIR_PI 3.14159265358979
+
+#define IIR_HP_FC 0.5f      // 高通截止频率，Hz
+#define IIR_HP_Q 0.7071f    // 巴特沃斯
+#define IIR_NOTCH_Q 30.0f   // 陷波带宽约 f0/30
+
+/**
+ * @brief 写入一级系数，a0归一化，a1/a2按CMSIS约定取反
+ */
+static uint8_t iir_add_stage(IIR_t *iir, double b0, double b1, double b2, double a0, double a1, double a2)
+{
+    double c[5];
+
+    if (iir->stages >= IIR_MAX_STAGES)
+        return 1;
+
+    c[0] = b0 / a0;
+    c[1] = b1 / a0;
+    c[2] = b2 / a0;
+    c[3] = -a1 / a0;
+    c[4] = -a2 / a0;
+    for (uint8_t i = 0; i < 5; i++)
+    {
+#if ECG_USE_FIXED_POINT
+        double q = round(c[i] * 1073741824.0); // 1.30格式
+
+        iir->coeffs_q31[5 * iir->stages + i] =
+            q >= 2147483647.0 ? INT32_MAX : (q <= -2147483648.0 ? INT32_MIN : (int32_t)q);
+#else
+        iir->coeffs[5 * iir->stages + i] = (float)c[i];
+#endif
+    }
+    iir->stages++;
+    IIR_Reset(iir);
+    return 0;
+}
+
+/**
+ * @brief 追加一级RBJ陷波
+ * @param f0: 陷波频率，Hz
+ * @param q: 品质因数，-3dB带宽为 f0/q
+ */
+uint8_t IIR_AddNotch(IIR_t *iir, float f0, float q, float fs)
+{
+    double w0 = 2.0 * IIR_PI * f0 / fs;
+    double alpha = sin(w0) / (2.0 * q);
+
+    return iir_add_stage(iir, 1.0, -2.0 * cos(w0), 1.0, 1.0 + alpha, -2.0 * cos(w0), 1.0 - alpha);
+}
+
+/**
+ * @brief 追加一级RBJ二阶高通
+ * @param fc: 截止频率，Hz
+ */
+uint8_t IIR_AddHighPass(IIR_t *iir, float fc, float q, float fs)
+{
+    double w0 = 2.0 * IIR_PI * fc / fs;
+    double alpha = sin(w0) / (2.0 * q);
+    double cw = cos(w0);
+
+    return iir_add_stage(iir, (1.0 + cw) / 2.0, -(1.0 + cw), (1.0 + cw) / 2.0,
+                         1.0 + alpha, -2.0 * cw, 1.0 - alpha);
+}
+
+/**
+ * @brief 按预设初始化，陷波频率高于奈奎斯特频率时跳过该级
+ */
+void IIR_Init(IIR_t *iir, uint8_t preset, float fs)
+{
+    memset(iir, 0, sizeof(IIR_t));
+
+    if (preset == IIR_PRESET_HP || preset == IIR_PRESET_HP_NOTCH50 || preset == IIR_PRESET_HP_NOTCH60)
+        IIR_AddHighPass(iir, IIR_HP_FC, IIR_HP_Q, fs);
+    if ((preset == IIR_PRESET_NOTCH50 || preset == IIR_PRESET_HP_NOTCH50) && fs > 100.0f)
+        IIR_AddNotch(iir, 50.0f, IIR_NOTCH_Q, fs);
+    if ((preset == IIR_PRESET_NOTCH60 || preset == IIR_PRESET_HP_NOTCH60) && fs > 120.0f)
+        IIR_AddNotch(iir, 60.0f, IIR_NOTCH_Q, fs);
+    IIR_Reset(iir);
+}
+
+void IIR_Reset(IIR_t *iir)
+{
+#if ECG_USE_FIXED_POINT
+    memset(iir->state_q31, 0, sizeof(iir->state_q31));
+#ifdef ARM_MATH_CM4
+    if (iir->stages > 0)
+        arm_biquad_cas_df1_32x64_init_q31(&iir->q31, iir->stages, iir->coeffs_q31, iir->state_q31, 1);
+#endif
+#else
+    memset(iir->state, 0, sizeof(iir->state));
+#ifdef ARM_MATH_CM4
+    if (iir->stages > 0)
+        arm_biquad_cascade_df2T_init_f32(&iir->f32, iir->stages, iir->coeffs, iir->state);
+#endif
+#endif
+}
+
+float IIR_Coeff(const IIR_t *iir, uint8_t stage, uint8_t k)
+{
+#if ECG_USE_FIXED_POINT
+    return iir->coeffs_q31[5 * stage + k] / 1073741824.0f;
+#else
+    return iir->coeffs[5 * stage + k];
+#endif
+}
+
+#if !ECG_USE_FIXED_POINT
+/**
+ * @brief 浮点IIR，直通时原样返回
+ */
+ECG_RAMFUNC(IIR) float IIR_Process(IIR_t *iir, float input)
+{
+    float output = input;
+
+    if (iir->stages == 0)
+        return input;
+#ifdef ARM_MATH_CM4
+    arm_biquad_cascade_df2T_f32(&iir->f32, &input, &output, 1);
+#else
+    for (uint8_t s = 0; s < iir->stages; s++)
+    {
+        const float *c = &iir->coeffs[5 * s];
+        float *d = &iir->state[2 * s];
+        float x = output;
+
+        output = c[0] * x + d[0];
+        d[0] = c[1] * x + c[3] * output + d[1];
+        d[1] = c[2] * x + c[4] * output;
+    }
+#endif
+    return output;
+}
+#else
+#ifndef ARM_MATH_CM4
+/**
+ * @brief 64位状态乘以32位系数并右移32位，与CMSIS的mult32x64相同，由两个32x32部分积组成
+ */
+static inline int64_t iir_mult32x64(int64_t x, int32_t y)
+{
+    return ((int64_t)(x & 0xffffffff) * y >> 32) + (x >> 32) * y;
+}
+#endif
+
+/**
+ * @brief Q31 IIR，状态保留64位精度
+ *        与arm_biquad_cas_df1_32x64_q31相同，输出取累加结果的高位，不做饱和
+ */
+ECG_RAMFUNC(IIR) int32_t IIR_ProcessQ31(IIR_t *iir, int32_t input)
+{
+    int32_t output = input;
+
+    if (iir->stages == 0)
+        return input;
+#ifdef ARM_MATH_CM4
+    arm_biquad_cas_df1_32x64_q31(&iir->q31, &input, &output, 1);
+#else
+    for (uint8_t s = 0; s < iir->stages; s++)
+    {
+        const int32_t *c = &iir->coeffs_q31[5 * s];
+        int64_t *d = &iir->state_q31[4 * s];
+        int32_t x = output;
+        int64_t acc;
+
+        // 系数为1.30格式：x项为Q31*Q30=Q61，y项为Q63*Q30>>32=Q61
+        acc = (int64_t)c[0] * x + (int64_t)c[1] * d[0] + (int64_t)c[2] * d[1];
+        acc += iir_mult32x64(d[2], c[3]) + iir_mult32x64(d[3], c[4]);
+        d[1] = d[0];
+        d[0] = x;
+        d[3] = d[2];
+        d[2] = (int64_t)((uint64_t)acc << 2); // postShift=1，Q61转为Q63
+        output = (int32_t)(d[2] >> 32);
+    }
+#endif
+    return output;
+}
+#endif
+
+/**
+ * @brief 多项式 sum(p[k] z^-k) 在频率w处的群延迟
+ */
+static double iir_poly_delay(const double *p, double w)
+{
+    double re = 0.0, im = 0.0, dre = 0.0, dim = 0.0;
+
+    for (uint8_t k = 0; k < 3; k++)
+    {
+        re += p[k] * cos(w * k);
+        im -= p[k] * sin(w * k);
+        dre += k * p[k] * cos(w * k);
+        dim -= k * p[k] * sin(w * k);
+    }
+    // Re{ sum(k p_k e^-jwk) / sum(p_k e^-jwk) }
+    return (dre * re + dim * im) / (re * re + im * im + 1e-30);
+}
+
+/**
+ * @brief 级联的群延迟，用于与线性相位FIR的 (taps-1)/2 比较及R峰时刻补偿
+ * @param f: 频率，Hz
+ * @return 群延迟，单位样本
+ */
+float IIR_GroupDelay(const IIR_t *iir, float f, float fs)
+{
+    double w = 2.0 * IIR_PI * f / fs;
+    double delay = 0.0;
+
+    for (uint8_t s = 0; s < iir->stages; s++)
+    {
+        double b[3] = {IIR_Coeff(iir, s, 0), IIR_Coeff(iir, s, 1), IIR_Coeff(iir, s, 2)};
+        double a[3] = {1.0, -IIR_Coeff(iir, s, 3), -IIR_Coeff(iir, s, 4)};
+
+        delay += iir_poly_delay(b, w) - iir_poly_delay(a, w);
+    }
+    return (float)delay;
+}
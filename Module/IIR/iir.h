@@ -0,0 +1,60 @@
+#ifndef IIR_H
+#define IIR_H
+
+#include "stdint.h"
+
+#include "ecg_conf.h"
+
+/*
+ * 双二阶IIR级联：浮点为DF2T(arm_biquad_cascade_df2T_f32)，
+ * Q31为64位状态的DF1(arm_biquad_cas_df1_32x64_q31)，低频极点下定点DF2T的量化噪声过大
+ * 按 ECG_USE_FIXED_POINT 只编译其中一种，主机端用与CMSIS相同算法的C实现
+ * 系数按CMSIS约定每级 {b0, b1, b2, a1, a2}，y = b0*x + b1*x1 + b2*x2 + a1*y1 + a2*y2
+ */
+
+#ifdef ARM_MATH_CM4
+#include "arm_math.h"
+#endif
+
+#define IIR_MAX_STAGES 3
+
+/* 预设，可在运行时切换 */
+#define IIR_PRESET_NONE 0     // 直通
+#define IIR_PRESET_NOTCH50 1  // 50Hz陷波
+#define IIR_PRESET_NOTCH60 2  // 60Hz陷波
+#define IIR_PRESET_HP 3       // 0.5Hz高通，去除基线漂移
+#define IIR_PRESET_HP_NOTCH50 4 // 高通+50Hz陷波
+#define IIR_PRESET_HP_NOTCH60 5 // 高通+60Hz陷波
+#define IIR_PRESET_COUNT 6
+
+typedef struct
+{
+    uint8_t stages;
+#if ECG_USE_FIXED_POINT
+    int32_t coeffs_q31[5 * IIR_MAX_STAGES]; // 按 1/2 缩放，postShift=1
+    int64_t state_q31[4 * IIR_MAX_STAGES];  // 每级 x1, x2, y1, y2，y为Q63
+#ifdef ARM_MATH_CM4
+    arm_biquad_cas_df1_32x64_ins_q31 q31;
+#endif
+#else
+    float coeffs[5 * IIR_MAX_STAGES];
+    float state[2 * IIR_MAX_STAGES];
+#ifdef ARM_MATH_CM4
+    arm_biquad_cascade_df2T_instance_f32 f32;
+#endif
+#endif
+} IIR_t;
+
+void IIR_Init(IIR_t *iir, uint8_t preset, float fs);             // 按预设与采样率设计并清空状态
+uint8_t IIR_AddNotch(IIR_t *iir, float f0, float q, float fs);   // 追加一级RBJ陷波，级数已满时返回1
+uint8_t IIR_AddHighPass(IIR_t *iir, float fc, float q, float fs); // 追加一级RBJ二阶高通
+void IIR_Reset(IIR_t *iir);                                      // 系数改变后清空状态并重新初始化实例
+#if ECG_USE_FIXED_POINT
+int32_t IIR_ProcessQ31(IIR_t *iir, int32_t input);               // Q31，输入一个样本
+#else
+float IIR_Process(IIR_t *iir, float input);                      // 浮点，输入一个样本
+#endif
+float IIR_Coeff(const IIR_t *iir, uint8_t stage, uint8_t k);     // 第stage级的第k个系数，按CMSIS约定
+float IIR_GroupDelay(const IIR_t *iir, float f, float fs);       // 频率f处的群延迟，单位样本
+
+#endif // !IIR_H
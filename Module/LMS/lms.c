@@ -0,0 +1,131 @@
+#include "lms.h"
+#include "ecg_conf.h"
+#include <math.h>
+#include <string.h>
+
+#define LMS_PI 3.14159265f
+#define LMS_TRACK_RANGE 2.0f // 频率跟踪范围，标称值±2Hz
+#define LMS_TRACK_GAIN 0.5f  // 每块修正测得频差的一半
+
+/**
+ * @brief 按当前频率设置振荡器的旋转步进
+ */
+static void lms_set_freq(LMS_t *lms, float freq)
+{
+    float w = 2.0f * LMS_PI * freq / lms->fs;
+
+    lms->freq = freq;
+    lms->rot_c = cosf(w);
+    lms->rot_s = sinf(w);
+}
+
+/**
+ * @brief 初始化
+ * @param f_nominal: 标称工频，50或60Hz
+ * @param harmonics: 抵消的谐波数(含基波)，奈奎斯特频率以上的谐波自动去掉
+ * @param mu: LMS步长，收敛时间约 1/mu 个样本
+ * @param min_amp: 频率跟踪的最小基波幅值，与输入同一刻度
+ */
+void LMS_Init(LMS_t *lms, float f_nominal, uint8_t harmonics, float fs, float mu, float min_amp)
+{
+    memset(lms, 0, sizeof(LMS_t));
+    lms->fs = fs;
+    lms->f_nominal = f_nominal;
+    lms->mu = mu;
+    lms->min_amp = min_amp;
+
+    if (harmonics > LMS_MAX_HARMONICS)
+        harmonics = LMS_MAX_HARMONICS;
+    while (harmonics > 0 && harmonics * (f_nominal + LMS_TRACK_RANGE) >= fs / 2.0f)
+        harmonics--;
+    lms->harmonics = harmonics;
+
+    lms->osc_c = 1.0f;
+    lms->block = (uint16_t)(fs / 10.0f); // 0.1s一块，频差2Hz时每块旋转不到π
+    lms_set_freq(lms, f_nominal);
+}
+
+/**
+ * @brief 每块测量基波权值的旋转角度，修正振荡器频率
+ */
+static void lms_track(LMS_t *lms)
+{
+    float c = lms->w_c[0], s = -lms->w_s[0]; // 权值相量 W = w_c - j*w_s
+    float dc = c * lms->last_c + s * lms->last_s; // W * conj(W_last)
+    float ds = s * lms->last_c - c * lms->last_s;
+    float amp2 = c * c + s * s;
+
+    if (amp2 > lms->min_amp * lms->min_amp && lms->last_c * lms->last_c + lms->last_s * lms->last_s > 0.0f)
+    {
+        float df = atan2f(ds, dc) * lms->fs / (2.0f * LMS_PI * lms->block);
+        float freq = lms->freq + LMS_TRACK_GAIN * df;
+
+        if (freq > lms->f_nominal + LMS_TRACK_RANGE)
+            freq = lms->f_nominal + LMS_TRACK_RANGE;
+        else if (freq < lms->f_nominal - LMS_TRACK_RANGE)
+            freq = lms->f_nominal - LMS_TRACK_RANGE;
+        lms_set_freq(lms, freq);
+    }
+    lms->last_c = c;
+    lms->last_s = s;
+}
+
+/**
+ * @brief 输入一个样本，估计并减去工频干扰
+ */
+ECG_RAMFUNC(LMS) float LMS_Process(LMS_t *lms, float input)
+{
+    float ref_c[LMS_MAX_HARMONICS], ref_s[LMS_MAX_HARMONICS];
+    float est = 0.0f, err, c, s, g;
+
+    if (lms->harmonics == 0)
+        return input;
+
+    // 第k次谐波的参考由基波相量的k次幂递推得到
+    ref_c[0] = lms->osc_c;
+    ref_s[0] = lms->osc_s;
+    for (uint8_t k = 1; k < lms->harmonics; k++)
+    {
+        ref_c[k] = ref_c[k - 1] * lms->osc_c - ref_s[k - 1] * lms->osc_s;
+        ref_s[k] = ref_s[k - 1] * lms->osc_c + ref_c[k - 1] * lms->osc_s;
+    }
+    for (uint8_t k = 0; k < lms->harmonics; k++)
+    {
+        est += lms->w_c[k] * ref_c[k] + lms->w_s[k] * ref_s[k];
+    }
+
+    err = input - est;
+    for (uint8_t k = 0; k < lms->harmonics; k++)
+    {
+        lms->w_c[k] += 2.0f * lms->mu * err * ref_c[k];
+        lms->w_s[k] += 2.0f * lms->mu * err * ref_s[k];
+    }
+
+    // 旋转振荡器，一阶修正幅值防止累积误差
+    c = lms->osc_c * lms->rot_c - lms->osc_s * lms->rot_s;
+    s = lms->osc_s * lms->rot_c + lms->osc_c * lms->rot_s;
+    g = 1.5f - 0.5f * (c * c + s * s);
+    lms->osc_c = c * g;
+    lms->osc_s = s * g;
+
+    if (++lms->block_pos >= lms->block)
+    {
+        lms->block_pos = 0;
+        lms_track(lms);
+    }
+    return err;
+}
+
+/**
+ * @brief 干扰幅值，作为信号质量指标
+ */
+float LMS_Amplitude(const LMS_t *lms)
+{
+    float sum = 0.0f;
+
+    for (uint8_t k = 0; k < lms->harmonics; k++)
+    {
+        sum += sqrtf(lms->w_c[k] * lms->w_c[k] + lms->w_s[k] * lms->w_s[k]);
+    }
+    return sum;
+}
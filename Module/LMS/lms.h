@@ -0,0 +1,41 @@
+#ifndef LMS_H
+#define LMS_H
+
+#include "stdint.h"
+
+/*
+ * 自适应工频干扰抵消：正交参考振荡器产生基波与各次谐波的 cos/sin，
+ * LMS更新每个分量的两路权值，输出为输入减去干扰估计，每个样本 O(谐波数)
+ * 工频漂移时基波权值矢量以频差旋转，按块测量旋转角度修正振荡器频率
+ * 不依赖HAL，可在主机端编译
+ */
+
+#define LMS_MAX_HARMONICS 3
+
+typedef struct
+{
+    float fs;
+    float f_nominal; // 标称工频
+    float freq;      // 当前跟踪到的工频
+    float mu;        // 步长
+    float min_amp;   // 基波幅值低于此值时不做频率跟踪
+    uint8_t harmonics;
+
+    /* 基波参考振荡器，复数相量逐样本旋转 */
+    float osc_c, osc_s;
+    float rot_c, rot_s;
+
+    float w_c[LMS_MAX_HARMONICS]; // cos分量权值
+    float w_s[LMS_MAX_HARMONICS]; // sin分量权值
+
+    /* 频率跟踪 */
+    uint16_t block;     // 每block个样本测一次旋转角度
+    uint16_t block_pos;
+    float last_c, last_s; // 上一块结束时的基波权值
+} LMS_t;
+
+void LMS_Init(LMS_t *lms, float f_nominal, uint8_t harmonics, float fs, float mu, float min_amp); // 初始化
+float LMS_Process(LMS_t *lms, float input); // 输入一个样本，返回去除干扰后的样本
+float LMS_Amplitude(const LMS_t *lms);      // 干扰幅值估计(各次谐波合成的峰值)，与输入同一刻度
+
+#endif // !LMS_H
@@ -0,0 +1,95 @@
+#include "ecg_latency.h"
+#include <stdio.h>
+#include <string.h>
+
+#define LAT_POINT_NAME(id, name) name,
+static const char *const lat_point_name[LAT_POINT_NUM] = {ECG_LAT_POINTS(LAT_POINT_NAME)};
+#undef LAT_POINT_NAME
+#define LAT_PATH_NAME(id, name) name,
+static const char *const lat_path_name[LAT_PATH_NUM] = {ECG_LAT_PATHS(LAT_PATH_NAME)};
+#undef LAT_PATH_NAME
+
+static PROF_Stat_t lat_stat[LAT_POINT_NUM];
+static uint32_t lat_miss[LAT_POINT_NUM];
+static PROF_Stat_t lat_path_stat[LAT_PATH_NUM];
+static uint32_t lat_deadline = UINT32_MAX;
+
+/**
+ * @brief 设置截止时间
+ * @param ticks: 与PROF_Now同单位，固件中为 SystemCoreClock / 采样率
+ */
+void LAT_SetDeadline(uint32_t ticks)
+{
+    lat_deadline = ticks;
+}
+
+/**
+ * @brief 记录一次延迟，超过截止时间计为一次超时
+ */
+void LAT_Record(LAT_Point_e point, uint32_t ticks)
+{
+    PROF_StatAdd(&lat_stat[point], ticks);
+    if (ticks > lat_deadline)
+        lat_miss[point]++;
+}
+
+uint32_t LAT_GetMiss(LAT_Point_e point)
+{
+    return lat_miss[point];
+}
+
+const PROF_Stat_t *LAT_GetStat(LAT_Point_e point)
+{
+    return &lat_stat[point];
+}
+
+/**
+ * @brief 记录一次支路信号延迟，包含群延迟，不与截止时间比较
+ */
+void LAT_PathRecord(LAT_Path_e path, uint32_t ticks)
+{
+    PROF_StatAdd(&lat_path_stat[path], ticks);
+}
+
+const PROF_Stat_t *LAT_GetPathStat(LAT_Path_e path)
+{
+    return &lat_path_stat[path];
+}
+
+void LAT_Reset(void)
+{
+    memset(lat_stat, 0, sizeof(lat_stat));
+    memset(lat_miss, 0, sizeof(lat_miss));
+    memset(lat_path_stat, 0, sizeof(lat_path_stat));
+}
+
+/**
+ * @brief 输出各观测点的延迟：次数、最小、平均、p99、最大、超时次数
+ */
+void LAT_Dump(void)
+{
+    printf("LAT deadline=%lu\n", (unsigned long)lat_deadline);
+    for (uint8_t i = 0; i < LAT_POINT_NUM; i++)
+    {
+        const PROF_Stat_t *stat = &lat_stat[i];
+
+        if (stat->count == 0)
+            continue;
+        printf("LAT %s n=%lu min=%lu mean=%lu p99=%lu max=%lu miss=%lu\n", lat_point_name[i],
+               (unsigned long)stat->count, (unsigned long)stat->min,
+               (unsigned long)(stat->sum / stat->count),
+               (unsigned long)PROF_Percentile(stat, 99), (unsigned long)stat->max,
+               (unsigned long)lat_miss[i]);
+    }
+    for (uint8_t i = 0; i < LAT_PATH_NUM; i++)
+    {
+        const PROF_Stat_t *stat = &lat_path_stat[i];
+
+        if (stat->count == 0)
+            continue;
+        printf("LAT path %s n=%lu min=%lu mean=%lu p99=%lu max=%lu\n", lat_path_name[i],
+               (unsigned long)stat->count, (unsigned long)stat->min,
+               (unsigned long)(stat->sum / stat->count),
+               (unsigned long)PROF_Percentile(stat, 99), (unsigned long)stat->max);
+    }
+}
@@ -0,0 +1,48 @@
+#ifndef ECG_LATENCY_H
+#define ECG_LATENCY_H
+
+#include "stdint.h"
+#include "ecg_prof.h"
+
+/*
+ * 单个样本的端到端延迟：从DRDY中断(HAL_GPIO_EXTI_Callback入口)打上时间戳，
+ * 随样本经过流水线，在各观测点记录 当前时间-时间戳，超过一个采样周期记为超时
+ * 各支路的信号延迟另行统计：处理时间加上滤波器群延迟与检测器的判决延迟，不计超时
+ * 观测点由信号核心的 ECG_LAT_MARK 记录，时间取自端口的 now()，主机端同样可用
+ */
+
+#define ECG_LAT_POINTS(X)     \
+    X(FILTER, "filter")       \
+    X(TELEMETRY, "telemetry") \
+    X(DISPLAY, "display")
+
+#define ECG_LAT_PATHS(X)  \
+    X(DISPLAY, "display") \
+    X(DETECT, "detect")
+
+#define LAT_POINT_ID(id, name) LAT_##id,
+typedef enum
+{
+    ECG_LAT_POINTS(LAT_POINT_ID)
+    LAT_POINT_NUM
+} LAT_Point_e;
+#undef LAT_POINT_ID
+
+#define LAT_PATH_ID(id, name) LAT_PATH_##id,
+typedef enum
+{
+    ECG_LAT_PATHS(LAT_PATH_ID)
+    LAT_PATH_NUM
+} LAT_Path_e;
+#undef LAT_PATH_ID
+
+void LAT_SetDeadline(uint32_t ticks);                // 设置截止时间，一般为一个采样周期
+void LAT_Record(LAT_Point_e point, uint32_t ticks);  // 记录一次延迟
+uint32_t LAT_GetMiss(LAT_Point_e point);             // 超时次数
+const PROF_Stat_t *LAT_GetStat(LAT_Point_e point);   // 读取单个观测点的统计
+void LAT_PathRecord(LAT_Path_e path, uint32_t ticks); // 记录一次支路信号延迟
+const PROF_Stat_t *LAT_GetPathStat(LAT_Path_e path); // 读取单个支路的统计
+void LAT_Reset(void);                                // 清空统计
+void LAT_Dump(void);                                 // 通过printf输出统计
+
+#endif // !ECG_LATENCY_H
@@ -0,0 +1,127 @@
+#include "ecg_mem.h"
+#include <stdio.h>
+
+#ifdef USE_HAL_DRIVER
+#include "FreeRTOS.h"
+#include "task.h"
+/* 快照由defaultTask写入、ECG任务读取，整体拷贝时关中断，避免读到一半被更新 */
+#define MEM_LOCK() taskENTER_CRITICAL()
+#define MEM_UNLOCK() taskEXIT_CRITICAL()
+#else
+#define MEM_LOCK()
+#define MEM_UNLOCK()
+#endif
+
+static MEM_Snapshot_t mem_snap;
+static uint8_t mem_updated; // 有尚未输出的新快照，与快照一起在临界区内读写
+static uint8_t mem_warned;  // 告警只在进入低余量时输出一次
+
+#ifdef USE_HAL_DRIVER
+
+/* 链接脚本导出的符号 */
+extern uint8_t _sdata, _ebss, _sdsp_bss, _edsp_bss, _estack;
+
+/**
+ * @brief 采样各任务栈高水位与堆余量，在 defaultTask 中周期调用
+ */
+void MEM_Sample(void)
+{
+    static TaskStatus_t status[MEM_TASK_MAX]; // defaultTask栈只有512字节，不放在栈上
+    static MEM_Snapshot_t snap;               // 先在这里采样，完成后一次性拷贝到共享快照
+    uint32_t num = uxTaskGetSystemState(status, MEM_TASK_MAX, NULL);
+
+    snap.stack_min = UINT32_MAX;
+    for (uint32_t i = 0; i < num; i++)
+    {
+        uint32_t free = status[i].usStackHighWaterMark * sizeof(StackType_t);
+
+        snap.task[i].name = status[i].pcTaskName;
+        snap.task[i].stack_free = free;
+        if (free < snap.stack_min)
+            snap.stack_min = free;
+    }
+    snap.task_num = num;
+    snap.heap_total = configTOTAL_HEAP_SIZE;
+    snap.heap_free = xPortGetFreeHeapSize();
+    snap.heap_min = xPortGetMinimumEverFreeHeapSize();
+    snap.dsp_bss = &_edsp_bss - &_sdsp_bss;
+    snap.ram_static = &_ebss - &_sdata;
+    snap.ram_total = &_estack - &_sdata;
+
+    MEM_LOCK();
+    mem_snap = snap;
+    mem_updated = 1;
+    MEM_UNLOCK();
+}
+#else
+void MEM_Sample(void)
+{
+}
+#endif
+
+/**
+ * @brief 输出最新快照
+ * @param telemetry: 非0时输出 {stack_min}、{heap_min} 遥测
+ */
+void MEM_Report(uint8_t telemetry)
+{
+    MEM_Snapshot_t snap;
+    uint8_t updated, low;
+
+    MEM_LOCK();
+    updated = mem_updated;
+    mem_updated = 0;
+    if (updated)
+        snap = mem_snap;
+    MEM_UNLOCK();
+    if (!updated)
+        return;
+
+    if (telemetry)
+    {
+        printf("{stack_min}");
+        printf("%lu\n", (unsigned long)snap.stack_min);
+        printf("{heap_min}");
+        printf("%lu\n", (unsigned long)snap.heap_min);
+    }
+
+    low = snap.stack_min < MEM_STACK_WARN || snap.heap_min < MEM_HEAP_WARN;
+    if (low && !mem_warned)
+    {
+        for (uint8_t i = 0; i < snap.task_num; i++)
+        {
+            if (snap.task[i].stack_free < MEM_STACK_WARN)
+                printf("WARN stack %s free=%lu\n", snap.task[i].name,
+                       (unsigned long)snap.task[i].stack_free);
+        }
+        if (snap.heap_min < MEM_HEAP_WARN)
+            printf("WARN heap min=%lu\n", (unsigned long)snap.heap_min);
+    }
+    mem_warned = low;
+}
+
+/**
+ * @brief 输出内存预算：各任务栈余量、堆、DSP缓冲区与静态RAM
+ */
+void MEM_Dump(void)
+{
+    MEM_Snapshot_t snap;
+
+    MEM_GetSnapshot(&snap);
+    for (uint8_t i = 0; i < snap.task_num; i++)
+        printf("MEM stack %s free=%lu\n", snap.task[i].name, (unsigned long)snap.task[i].stack_free);
+    printf("MEM heap total=%lu free=%lu min=%lu\n", (unsigned long)snap.heap_total,
+           (unsigned long)snap.heap_free, (unsigned long)snap.heap_min);
+    printf("MEM ram static=%lu total=%lu dsp=%lu\n", (unsigned long)snap.ram_static,
+           (unsigned long)snap.ram_total, (unsigned long)snap.dsp_bss);
+}
+
+/**
+ * @brief 拷贝一份最新快照，可在任意任务中调用
+ */
+void MEM_GetSnapshot(MEM_Snapshot_t *snap)
+{
+    MEM_LOCK();
+    *snap = mem_snap;
+    MEM_UNLOCK();
+}
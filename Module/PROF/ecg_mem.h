@@ -0,0 +1,41 @@
+#ifndef ECG_MEM_H
+#define ECG_MEM_H
+
+#include "stdint.h"
+
+/*
+ * 内存余量监控：任务栈高水位、堆最小剩余、链接脚本中的DSP缓冲区与静态RAM占用
+ * defaultTask 周期性调用 MEM_Sample 采样，ECG任务调用 MEM_Report 输出，避免两个任务同时printf
+ * 共享快照只在临界区内整体拷贝，读取方拿到的总是同一次采样的结果
+ */
+
+#define MEM_SAMPLE_PERIOD_MS 1000 // 采样周期
+#define MEM_STACK_WARN 128        // 任务栈剩余低于该字节数时告警
+#define MEM_HEAP_WARN 1024        // 堆历史最小剩余低于该字节数时告警
+#define MEM_TASK_MAX 8            // 监控的最大任务数
+
+typedef struct
+{
+    const char *name;
+    uint32_t stack_free; // 栈高水位，单位字节
+} MEM_Task_t;
+
+typedef struct
+{
+    MEM_Task_t task[MEM_TASK_MAX];
+    uint8_t task_num;
+    uint32_t stack_min;  // 所有任务中最小的栈余量
+    uint32_t heap_total; // configTOTAL_HEAP_SIZE
+    uint32_t heap_free;
+    uint32_t heap_min;   // 上电以来堆的最小剩余
+    uint32_t dsp_bss;    // CCM RAM中 .bss.dsp 段大小，即DSP缓冲区总量
+    uint32_t ram_static; // .data + .bss 占用
+    uint32_t ram_total;
+} MEM_Snapshot_t;
+
+void MEM_Sample(void);                     // 采样一次，只更新快照
+void MEM_Report(uint8_t telemetry);        // 有新快照时输出遥测与告警
+void MEM_Dump(void);                       // 输出完整的内存预算
+void MEM_GetSnapshot(MEM_Snapshot_t *snap);  // 在临界区内拷贝最新快照
+
+#endif // !ECG_MEM_H
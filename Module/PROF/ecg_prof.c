@@ -0,0 +1,105 @@
+#include "ecg_prof.h"
+#include <stdio.h>
+#include <string.h>
+
+#define PROF_ZONE_NAME(id, name) name,
+static const char *const prof_zone_name[PROF_ZONE_NUM] = {ECG_PROF_ZONES(PROF_ZONE_NAME)};
+#undef PROF_ZONE_NAME
+
+static PROF_Stat_t prof_stat[PROF_ZONE_NUM];
+
+/**
+ * @brief 耗时对应的直方图格：[2^k, 1.5*2^k) 为第2k格，[1.5*2^k, 2^(k+1)) 为第2k+1格
+ */
+uint8_t PROF_Bin(uint32_t ticks)
+{
+    uint8_t k;
+
+    if (ticks < 2)
+        return (uint8_t)ticks;
+    k = 31 - __builtin_clz(ticks);
+    return (uint8_t)(2 * k + ((ticks >> (k - 1)) & 1));
+}
+
+/**
+ * @brief 直方图格的上界(含)
+ */
+uint32_t PROF_BinUpper(uint8_t bin)
+{
+    uint8_t k = bin / 2;
+
+    if (bin < 2)
+        return bin;
+    if (bin & 1)
+        return k == 31 ? UINT32_MAX : (2u << k) - 1;
+    return (1u << k) + (1u << (k - 1)) - 1;
+}
+
+/**
+ * @brief 向统计结构中加入一个样本，延迟跟踪等模块共用
+ */
+void PROF_StatAdd(PROF_Stat_t *stat, uint32_t ticks)
+{
+    if (stat->count == 0 || ticks < stat->min)
+        stat->min = ticks;
+    if (ticks > stat->max)
+        stat->max = ticks;
+    stat->count++;
+    stat->sum += ticks;
+    stat->hist[PROF_Bin(ticks)]++;
+}
+
+/**
+ * @brief 记录一次耗时
+ * @param zone: 区间
+ * @param ticks: 耗时，固件中为CPU周期
+ */
+void PROF_Record(PROF_Zone_e zone, uint32_t ticks)
+{
+    PROF_StatAdd(&prof_stat[zone], ticks);
+}
+
+void PROF_Reset(void)
+{
+    memset(prof_stat, 0, sizeof(prof_stat));
+}
+
+const PROF_Stat_t *PROF_GetStat(PROF_Zone_e zone)
+{
+    return &prof_stat[zone];
+}
+
+/**
+ * @brief 由直方图估计百分位数，返回所在格的上界，误差不超过50%
+ */
+uint32_t PROF_Percentile(const PROF_Stat_t *stat, uint8_t percent)
+{
+    uint64_t target = ((uint64_t)stat->count * percent + 99) / 100;
+    uint64_t acc = 0;
+
+    for (uint8_t bin = 0; bin < PROF_HIST_BINS; bin++)
+    {
+        acc += stat->hist[bin];
+        if (acc >= target && acc > 0)
+            return PROF_BinUpper(bin) < stat->max ? PROF_BinUpper(bin) : stat->max;
+    }
+    return stat->max;
+}
+
+/**
+ * @brief 输出所有区间的统计：次数、最小、平均、p99、最大
+ */
+void PROF_Dump(void)
+{
+    for (uint8_t i = 0; i < PROF_ZONE_NUM; i++)
+    {
+        const PROF_Stat_t *stat = &prof_stat[i];
+
+        if (stat->count == 0)
+            continue;
+        printf("PROF %s n=%lu min=%lu mean=%lu p99=%lu max=%lu\n", prof_zone_name[i],
+               (unsigned long)stat->count, (unsigned long)stat->min,
+               (unsigned long)(stat->sum / stat->count),
+               (unsigned long)PROF_Percentile(stat, 99), (unsigned long)stat->max);
+    }
+}
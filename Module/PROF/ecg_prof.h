@@ -0,0 +1,87 @@
+#ifndef ECG_PROF_H
+#define ECG_PROF_H
+
+#include "stdint.h"
+#include "ecg_conf.h"
+
+/*
+ * 流水线耗时统计
+ * 固件中以DWT CYCCNT计时，单位为CPU周期；主机端以clock_gettime计时，单位为ns
+ * 用法：同一作用域内成对使用 PROF_BEGIN(FIR); ... PROF_END(FIR);
+ * ECG_PROF_ENABLE 为0时宏展开为空
+ */
+
+/* 统计区间列表，新增区间只需在此添加 */
+#define ECG_PROF_ZONES(X) \
+    X(ACQ, "acq")         \
+    X(UNPACK, "unpack")   \
+    X(IIR, "iir")         \
+    X(LMS, "lms")         \
+    X(BAND, "band")       \
+    X(FIR, "fir")         \
+    X(DECIM, "decim")     \
+    X(RING, "ring")       \
+    X(FFT, "fft")         \
+    X(MAG, "mag")         \
+    X(QRS, "qrs")         \
+    X(HRV, "hrv")         \
+    X(DRAW, "draw")       \
+    X(PRINTF, "printf")
+
+#define PROF_ZONE_ID(id, name) PROF_##id,
+typedef enum
+{
+    ECG_PROF_ZONES(PROF_ZONE_ID)
+    PROF_ZONE_NUM
+} PROF_Zone_e;
+#undef PROF_ZONE_ID
+
+#define PROF_HIST_BINS 64 // 每个2倍区间再分两格，覆盖整个32位范围
+
+typedef struct
+{
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t sum;
+    uint32_t hist[PROF_HIST_BINS];
+} PROF_Stat_t;
+
+#ifdef USE_HAL_DRIVER
+#include "main.h"
+static inline uint32_t PROF_Now(void)
+{
+    return DWT->CYCCNT;
+}
+#else
+#include <time.h>
+static inline uint32_t PROF_Now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec);
+}
+#endif
+
+#if ECG_PROF_ENABLE
+
+#define PROF_BEGIN(zone) uint32_t prof_t0_##zone = PROF_Now()
+#define PROF_END(zone) PROF_Record(PROF_##zone, PROF_Now() - prof_t0_##zone)
+
+#else
+
+#define PROF_BEGIN(zone)
+#define PROF_END(zone)
+
+#endif
+
+void PROF_Record(PROF_Zone_e zone, uint32_t ticks); // 记录一次耗时
+void PROF_StatAdd(PROF_Stat_t *stat, uint32_t ticks); // 向任意统计结构中加入一个样本
+void PROF_Reset(void);                              // 清空统计
+void PROF_Dump(void);                               // 通过printf输出统计
+const PROF_Stat_t *PROF_GetStat(PROF_Zone_e zone);  // 读取单个区间的统计
+uint32_t PROF_Percentile(const PROF_Stat_t *stat, uint8_t percent); // 由直方图估计百分位数
+uint8_t PROF_Bin(uint32_t ticks);                   // 耗时对应的直方图格
+uint32_t PROF_BinUpper(uint8_t bin);                // 直方图格的上界
+
+#endif // !ECG_PROF_H
@@ -0,0 +1,98 @@
+#include "ecg_trace.h"
+#include "ecg_prof.h"
+#include <stdio.h>
+#include <string.h>
+
+#ifdef USE_HAL_DRIVER
+#include "FreeRTOS.h"
+#include "task.h"
+#endif
+
+#define TRACE_TASK_MAX 8 // 参与占用率统计的最大任务数
+
+static TRACE_Event_t trace_ring[TRACE_RING_LEN];
+static uint32_t trace_head; // 已写入事件总数
+static uint8_t trace_freeze; // 导出期间暂停记录
+
+/**
+ * @brief 记录一个事件
+ * @note 会在PendSV与各级中断中调用，写入期间关中断
+ */
+void TRACE_Record(uint8_t event, uint16_t arg)
+{
+#ifdef USE_HAL_DRIVER
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+#endif
+    if (!trace_freeze)
+    {
+        TRACE_Event_t *ev = &trace_ring[trace_head & (TRACE_RING_LEN - 1)];
+        ev->time = PROF_Now();
+        ev->event = event;
+        ev->arg = arg;
+        trace_head++;
+    }
+#ifdef USE_HAL_DRIVER
+    __set_PRIMASK(primask);
+#endif
+}
+
+void TRACE_Reset(void)
+{
+    trace_freeze = 1;
+    trace_head = 0;
+    memset(trace_ring, 0, sizeof(trace_ring));
+    trace_freeze = 0;
+}
+
+/**
+ * @brief 从最旧到最新输出跟踪环，每行 "TRACE <time> <event> <arg>"
+ */
+void TRACE_Dump(void)
+{
+    uint32_t end, start;
+
+    trace_freeze = 1;
+    end = trace_head;
+    start = end > TRACE_RING_LEN ? end - TRACE_RING_LEN : 0;
+    for (uint32_t i = start; i < end; i++)
+    {
+        const TRACE_Event_t *ev = &trace_ring[i & (TRACE_RING_LEN - 1)];
+        printf("TRACE %lu %u %u\n", (unsigned long)ev->time, ev->event, ev->arg);
+    }
+    trace_freeze = 0;
+}
+
+#ifdef USE_HAL_DRIVER
+/**
+ * @brief 输出各任务的CPU占用率，每行 "TASK <编号> <名称> <千分比>"
+ * @note 以两次调用之间运行时间计数的增量计算，第一次调用为上电以来的平均值
+ */
+void TRACE_TaskDump(void)
+{
+    static uint32_t last_runtime[TRACE_TASK_MAX + 1];
+    static uint32_t last_total;
+    TaskStatus_t status[TRACE_TASK_MAX];
+    uint32_t total, num;
+
+    num = uxTaskGetSystemState(status, TRACE_TASK_MAX, &total);
+    if (num == 0 || total == last_total)
+        return;
+    for (uint32_t i = 0; i < num; i++)
+    {
+        uint32_t id = status[i].xTaskNumber;
+        uint32_t run = status[i].ulRunTimeCounter;
+        uint32_t prev = id <= TRACE_TASK_MAX ? last_runtime[id] : 0;
+
+        printf("TASK %lu %s %lu\n", (unsigned long)id, status[i].pcTaskName,
+               (unsigned long)((uint64_t)(run - prev) * 1000 / (total - last_total)));
+        if (id <= TRACE_TASK_MAX)
+            last_runtime[id] = run;
+    }
+    last_total = total;
+}
+#else
+void TRACE_TaskDump(void)
+{
+}
+#endif
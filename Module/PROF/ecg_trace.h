@@ -0,0 +1,41 @@
+#ifndef ECG_TRACE_H
+#define ECG_TRACE_H
+
+#include "stdint.h"
+#include "ecg_conf.h"
+
+/*
+ * RAM中的事件跟踪环，由FreeRTOS跟踪钩子(见FreeRTOSConfig.h)与中断入口/出口记录
+ * 时间戳为DWT CYCCNT，写满后覆盖最旧的事件，TRACE命令导出
+ */
+
+#define TRACE_RING_LEN 256 // 必须为2的幂
+
+/* 事件类型 */
+#define TRACE_EV_SWITCH 0     // 任务切入，参数为任务编号
+#define TRACE_EV_ISR_ENTER 1  // 进入中断，参数为IRQ号
+#define TRACE_EV_ISR_EXIT 2   // 退出中断，参数为IRQ号
+#define TRACE_EV_QUEUE_SEND 3 // 队列/信号量发送，参数为队列地址低16位
+#define TRACE_EV_QUEUE_RECV 4 // 队列/信号量接收，参数为队列地址低16位
+
+typedef struct
+{
+    uint32_t time; // CYCCNT
+    uint8_t event;
+    uint16_t arg;
+} TRACE_Event_t;
+
+#if ECG_PROF_ENABLE
+#define TRACE_ISR_ENTER(irq) TRACE_Record(TRACE_EV_ISR_ENTER, (uint16_t)(irq))
+#define TRACE_ISR_EXIT(irq) TRACE_Record(TRACE_EV_ISR_EXIT, (uint16_t)(irq))
+#else
+#define TRACE_ISR_ENTER(irq)
+#define TRACE_ISR_EXIT(irq)
+#endif
+
+void TRACE_Record(uint8_t event, uint16_t arg); // 记录一个事件，任务/中断中均可调用
+void TRACE_Reset(void);                         // 清空跟踪环
+void TRACE_Dump(void);                          // 按时间顺序输出跟踪环
+void TRACE_TaskDump(void);                      // 输出各任务自上次调用以来的CPU占用率
+
+#endif // !ECG_TRACE_H
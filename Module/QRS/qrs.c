@@ -0,0 +1,211 @@
+#include "qrs.h"
+#include "ecg_conf.h"
+#include <math.h>
+#include <string.h>
+
+#define QRS_PI 3.14159265f
+
+/**
+ * @brief 初始化检测器
+ * @param qrs: 检测器实例
+ * @param fs: 输入信号采样率，单位Hz
+ */
+void QRS_Init(QRS_t *qrs, float fs)
+{
+    float w0 = 2.0f * QRS_PI * 8.66f / fs; // 中心频率取 sqrt(5*15)
+    float alpha = sinf(w0) / (2.0f * 0.87f); // Q = 8.66 / (15 - 5)
+    float a0 = 1.0f + alpha;
+    uint32_t mwi_len = (uint32_t)(0.15f * fs + 0.5f);
+
+    memset(qrs, 0, sizeof(QRS_t));
+    qrs->fs = fs;
+    qrs->mwi_len = mwi_len > QRS_MWI_MAX ? QRS_MWI_MAX : (mwi_len < 1 ? 1 : mwi_len);
+    qrs->half_win = qrs->mwi_len / 2;
+    qrs->refractory = (uint32_t)(0.2f * fs);
+    qrs->twave_win = (uint32_t)(0.36f * fs);
+    qrs->learn_end = (uint32_t)(2.0f * fs);
+
+    qrs->b0 = alpha / a0;
+    qrs->b2 = -alpha / a0;
+    qrs->a1 = -2.0f * cosf(w0) / a0;
+    qrs->a2 = (1.0f - alpha) / a0;
+}
+
+/**
+ * @brief 在带通信号历史中回溯，取积分窗口内绝对值最大处为R峰
+ */
+static uint32_t qrs_locate_r(const QRS_t *qrs, uint32_t mwi_n)
+{
+    uint32_t start = mwi_n >= qrs->mwi_len ? mwi_n - qrs->mwi_len : 0;
+    uint32_t best_n = mwi_n;
+    float best = -1.0f;
+
+    if (qrs->n - start > QRS_HIST_LEN) // 回溯搜索的候选可能已超出历史范围
+        return mwi_n - qrs->half_win;
+
+    for (uint32_t i = start; i <= mwi_n; i++)
+    {
+        float v = fabsf(qrs->bp_hist[i % QRS_HIST_LEN]);
+        if (v > best)
+        {
+            best = v;
+            best_n = i;
+        }
+    }
+    return best_n;
+}
+
+/**
+ * @brief 确认一个QRS，更新阈值、RR间期与心率
+ */
+static void qrs_accept(QRS_t *qrs, uint32_t n, float peak, float slope, float weight)
+{
+    uint32_t r = qrs_locate_r(qrs, n);
+
+    qrs->spki = weight * peak + (1.0f - weight) * qrs->spki;
+    qrs->last_qrs_n = n;
+    qrs->last_slope = slope;
+    qrs->sb_val = 0.0f;
+
+    if (qrs->beats > 0)
+    {
+        qrs->rr = r - qrs->r_sample;
+        // 只用生理范围内的RR(0.2s-3s)更新均值
+        if (qrs->rr > 0.2f * qrs->fs && qrs->rr < 3.0f * qrs->fs)
+        {
+            qrs->rr_sum += qrs->rr - qrs->rr_buf[qrs->rr_pos];
+            qrs->rr_buf[qrs->rr_pos] = qrs->rr;
+            qrs->rr_pos = (qrs->rr_pos + 1) % QRS_RR_AVG_NUM;
+            if (qrs->rr_count < QRS_RR_AVG_NUM)
+                qrs->rr_count++;
+            qrs->bpm = 60.0f * qrs->fs * qrs->rr_count / qrs->rr_sum;
+        }
+    }
+    qrs->r_sample = r;
+    qrs->beats++;
+}
+
+/**
+ * @brief 对积分信号上确认的一个峰进行分类
+ * @return 1:判为QRS
+ */
+static uint8_t qrs_classify(QRS_t *qrs, uint32_t n, float peak, float slope)
+{
+    if (n < qrs->learn_end) // 学习阶段只统计
+    {
+        if (peak > qrs->learn_max)
+            qrs->learn_max = peak;
+        return 0;
+    }
+    if (qrs->beats > 0 && n - qrs->last_qrs_n < qrs->refractory)
+        return 0;
+
+    if (peak > qrs->thr1)
+    {
+        // 上个QRS后360ms内且斜率不到其一半，判为T波
+        if (qrs->beats > 0 && n - qrs->last_qrs_n < qrs->twave_win && slope < 0.5f * qrs->last_slope)
+        {
+            qrs->npki = 0.125f * peak + 0.875f * qrs->npki;
+        }
+        else
+        {
+            qrs_accept(qrs, n, peak, slope, 0.125f);
+            return 1;
+        }
+    }
+    else
+    {
+        qrs->npki = 0.125f * peak + 0.875f * qrs->npki;
+        if (peak > qrs->thr2 && peak > qrs->sb_val)
+        {
+            qrs->sb_val = peak;
+            qrs->sb_n = n;
+            qrs->sb_slope = slope;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief 输入一个滤波后的样本
+ * @param qrs: 检测器实例
+ * @param x: 输入样本，刻度任意
+ * @return 1:检出新的心拍，结果在 r_sample/rr/bpm 中
+ */
+ECG_RAMFUNC(QRS) uint8_t QRS_Process(QRS_t *qrs, float x)
+{
+    uint8_t beat = 0;
+    float bp, d, sq, mwi;
+
+    /* 带通 */
+    bp = qrs->b0 * x + qrs->z1;
+    qrs->z1 = -qrs->a1 * bp + qrs->z2;
+    qrs->z2 = qrs->b2 * x - qrs->a2 * bp;
+    qrs->bp_hist[qrs->n % QRS_HIST_LEN] = bp;
+
+    /* 五点微分 (2x[n] + x[n-1] - x[n-3] - 2x[n-4]) / 8 */
+    d = (2.0f * bp + qrs->deriv_x[0] - qrs->deriv_x[2] - 2.0f * qrs->deriv_x[3]) * 0.125f;
+    qrs->deriv_x[3] = qrs->deriv_x[2];
+    qrs->deriv_x[2] = qrs->deriv_x[1];
+    qrs->deriv_x[1] = qrs->deriv_x[0];
+    qrs->deriv_x[0] = bp;
+
+    /* 平方与滑动窗口积分 */
+    sq = d * d;
+    qrs->mwi_sum += sq - qrs->mwi_buf[qrs->mwi_pos];
+    qrs->mwi_pass += sq;
+    qrs->mwi_buf[qrs->mwi_pos] = sq;
+    if (++qrs->mwi_pos >= qrs->mwi_len)
+    {
+        // 窗口写满一轮，本轮的平方和就是整个窗口的和，用它替换滑动和，累加误差不随记录长度增长
+        qrs->mwi_pos = 0;
+        qrs->mwi_sum = qrs->mwi_pass;
+        qrs->mwi_pass = 0.0f;
+    }
+    if (qrs->mwi_sum < 0.0f) // 一轮之内的浮点累加误差
+        qrs->mwi_sum = 0.0f;
+    mwi = qrs->mwi_sum / qrs->mwi_len;
+
+    if (fabsf(d) > qrs->slope_max)
+        qrs->slope_max = fabsf(d);
+
+    /* 峰值跟踪：上升沿上出现的新最大值，半个窗口内未被超过即确认 */
+    if (mwi > qrs->mwi_prev && mwi > qrs->cand_val)
+    {
+        qrs->cand_val = mwi;
+        qrs->cand_n = qrs->n;
+        qrs->cand_slope = qrs->slope_max;
+        qrs->cand_valid = 1;
+    }
+    else if (qrs->cand_valid && qrs->n - qrs->cand_n >= qrs->half_win)
+    {
+        beat = qrs_classify(qrs, qrs->cand_n, qrs->cand_val, qrs->cand_slope);
+        qrs->cand_val = 0.0f;
+        qrs->cand_valid = 0;
+        qrs->slope_max = 0.0f;
+    }
+    qrs->mwi_prev = mwi;
+
+    if (qrs->n < qrs->learn_end)
+    {
+        qrs->learn_sum += mwi;
+    }
+    else if (qrs->n == qrs->learn_end)
+    {
+        qrs->spki = qrs->learn_max / 3.0f;
+        qrs->npki = 0.5f * qrs->learn_sum / qrs->learn_end;
+    }
+
+    /* 超过1.66倍平均RR仍未检出，回溯取阈值2以上的最大峰 */
+    if (!beat && qrs->rr_count > 0 && qrs->sb_val > 0.0f &&
+        qrs->n - qrs->last_qrs_n > 1.66f * qrs->rr_sum / qrs->rr_count)
+    {
+        qrs_accept(qrs, qrs->sb_n, qrs->sb_val, qrs->sb_slope, 0.25f);
+        beat = 1;
+    }
+
+    qrs->thr1 = qrs->npki + 0.25f * (qrs->spki - qrs->npki);
+    qrs->thr2 = 0.5f * qrs->thr1;
+    qrs->n++;
+    return beat;
+}
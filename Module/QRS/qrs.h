@@ -0,0 +1,71 @@
+#ifndef QRS_H
+#define QRS_H
+
+#include "stdint.h"
+
+/*
+ * 流式QRS检测(Pan-Tompkins)：带通 -> 微分 -> 平方 -> 滑动窗口积分 -> 自适应阈值
+ * 每个样本O(1)，只在检出心拍时在一个积分窗口内回溯定位R峰
+ * 不依赖HAL，可在主机端编译
+ */
+
+#define QRS_MWI_MAX 320    // 积分窗口最大长度(150ms)，覆盖到2000SPS
+#define QRS_HIST_LEN (QRS_MWI_MAX * 2) // 带通信号历史，用于回溯定位R峰
+#define QRS_RR_AVG_NUM 8   // RR均值使用最近8个心拍
+
+typedef struct
+{
+    float fs;            // 采样率
+    uint16_t mwi_len;    // 积分窗口长度
+    uint16_t half_win;   // 峰值确认延迟
+    uint32_t refractory; // 不应期200ms
+    uint32_t twave_win;  // T波判别窗口360ms
+    uint32_t learn_end;  // 前2s用于初始化阈值
+
+    /* 带通滤波(5-15Hz)，DF2T双二阶 */
+    float b0, b2, a1, a2;
+    float z1, z2;
+
+    float deriv_x[4];          // 微分器历史
+    float mwi_buf[QRS_MWI_MAX]; // 平方后的信号，用于滑动求和
+    float mwi_sum;
+    float mwi_pass;            // 本轮(mwi_pos从0开始)写入的平方和
+    uint16_t mwi_pos;
+    float bp_hist[QRS_HIST_LEN]; // 带通信号历史
+    uint32_t n;                  // 已处理样本数
+
+    /* 积分信号的峰值跟踪 */
+    float mwi_prev;
+    float cand_val;
+    uint32_t cand_n;
+    float cand_slope;
+    float slope_max;
+    uint8_t cand_valid;
+
+    /* 自适应阈值 */
+    float spki, npki, thr1, thr2;
+    float learn_max, learn_sum;
+
+    /* 回溯搜索候选 */
+    float sb_val;
+    uint32_t sb_n;
+    float sb_slope;
+
+    /* 已检出的心拍 */
+    uint32_t last_qrs_n; // 上一个QRS在积分信号上的位置
+    float last_slope;
+    float rr_buf[QRS_RR_AVG_NUM];
+    float rr_sum;
+    uint8_t rr_pos, rr_count;
+
+    /* 输出 */
+    uint32_t r_sample; // 最近一个R峰的样本序号
+    uint32_t rr;       // 最近一个RR间期，单位样本
+    float bpm;         // 心率
+    uint32_t beats;    // 心拍计数
+} QRS_t;
+
+void QRS_Init(QRS_t *qrs, float fs);      // 按采样率初始化
+uint8_t QRS_Process(QRS_t *qrs, float x); // 输入一个样本，检出新心拍时返回1
+
+#endif // !QRS_H
@@ -0,0 +1,138 @@
+#include "goertzel.h"
+#include "ecg_conf.h"
+#include <math.h>
+#include <string.h>
+
+#define GZ_PI 3.14159265358979
+#define GZ_HANN_ENBW 1.5f // Hann窗的等效噪声带宽，单位频点
+
+/**
+ * @brief 初始化频带
+ * @param f_lo, f_hi: 频带范围Hz，相等时只跟踪一个频率
+ * @param fs: 采样率
+ */
+void GZ_Init(GZ_Band_t *b, float f_lo, float f_hi, float fs)
+{
+    float df;
+    uint32_t k_lo, k_hi;
+
+    memset(b, 0, sizeof(GZ_Band_t));
+    if (f_hi < f_lo)
+    {
+        float t = f_lo;
+        f_lo = f_hi;
+        f_hi = t;
+    }
+    b->f_lo = f_lo;
+    b->f_hi = f_hi;
+    b->decim = f_hi > 0.0f && fs / (GZ_OVERSAMPLE * f_hi) > 1.0f ? (uint16_t)(fs / (GZ_OVERSAMPLE * f_hi)) : 1;
+    fs /= b->decim;
+
+    // 频带内最多GZ_MAX_BINS个频点，分辨率不高于GZ_MIN_RESOLUTION；
+    // 下限距直流至少两个频点，且频点都取分辨率的整数倍，落在直流分量的Hann窗零点上，
+    // 为此细化的分辨率不超过 GZ_MIN_RESOLUTION/GZ_PHASES，块长不超过 GZ_PHASES*GZ_MAX_BLOCK_S
+    df = (f_hi - f_lo) / (GZ_MAX_BINS - 1);
+    if (df < GZ_MIN_RESOLUTION)
+        df = GZ_MIN_RESOLUTION;
+    if (f_lo > 0.0f && f_lo < 2.0f * df)
+        df = 0.5f * f_lo;
+    if (df < GZ_MIN_RESOLUTION / GZ_PHASES)
+        df = GZ_MIN_RESOLUTION / GZ_PHASES;
+    b->block = (uint32_t)(fs / df + 0.5f);
+    if (b->block < 2)
+        b->block = 2;
+    b->phases = b->block > (uint32_t)(GZ_MAX_BLOCK_S * fs + 0.5f) ? GZ_PHASES : 1;
+    b->running = 1;
+    df = fs / b->block;
+    k_lo = (uint32_t)ceilf(f_lo / df - 0.01f);
+    k_hi = (uint32_t)(f_hi / df + 0.01f);
+    if (k_hi < k_lo)
+        k_hi = k_lo;
+    b->bins = k_hi >= k_lo + GZ_MAX_BINS ? GZ_MAX_BINS : (uint8_t)(k_hi - k_lo + 1);
+
+    for (uint8_t i = 0; i < b->bins; i++)
+        b->coeff[i] = (float)(2.0 * cos(2.0 * GZ_PI * (k_lo + i) / b->block));
+    b->rot_c = (float)cos(2.0 * GZ_PI / b->block);
+    b->rot_s = (float)sin(2.0 * GZ_PI / b->block);
+    for (uint8_t p = 0; p < GZ_PHASES; p++)
+        b->win_c[p] = 1.0f;
+
+    // 幅值为A的正弦在频点上 |X| = A/2 * Σw，Σw = block/2，功率A²/2 = 2|X|²/(Σw)²
+    b->norm = 2.0f / (0.25f * b->block * b->block) / GZ_HANN_ENBW;
+}
+
+uint32_t GZ_BlockSamples(const GZ_Band_t *b)
+{
+    return b->block * b->decim;
+}
+
+uint32_t GZ_UpdateSamples(const GZ_Band_t *b)
+{
+    return b->block * b->decim / b->phases;
+}
+
+/**
+ * @brief 一组频点输入一个抽取后的样本
+ * @return 1:本组一块结束，power已更新
+ */
+static inline uint8_t gz_phase_step(GZ_Band_t *b, uint8_t ph, float x)
+{
+    float *s1 = b->s1[ph], *s2 = b->s2[ph];
+    float c = b->win_c[ph];
+    float xw = (x - b->dc[ph]) * (0.5f - 0.5f * c);
+    float p = 0.0f;
+
+    b->dc_acc[ph] += x;
+    b->win_c[ph] = c * b->rot_c - b->win_s[ph] * b->rot_s;
+    b->win_s[ph] = b->win_s[ph] * b->rot_c + c * b->rot_s;
+    for (uint8_t i = 0; i < b->bins; i++)
+    {
+        float s0 = xw + b->coeff[i] * s1[i] - s2[i];
+
+        s2[i] = s1[i];
+        s1[i] = s0;
+    }
+    if (++b->n[ph] < b->block)
+        return 0;
+
+    for (uint8_t i = 0; i < b->bins; i++)
+    {
+        p += s1[i] * s1[i] + s2[i] * s2[i] - b->coeff[i] * s1[i] * s2[i];
+        s1[i] = 0.0f;
+        s2[i] = 0.0f;
+    }
+    b->power = p * b->norm;
+    b->dc[ph] = b->dc_acc[ph] / b->block;
+    b->dc_acc[ph] = 0.0f;
+    b->blocks++;
+    b->n[ph] = 0;
+    b->win_c[ph] = 1.0f; // 每块重新开始，递推误差不会累积
+    b->win_s[ph] = 0.0f;
+    return 1;
+}
+
+/**
+ * @brief 输入一个样本，每decim个样本平均后更新一次频点
+ * @return 1:一块结束，power已更新
+ */
+ECG_RAMFUNC(GZ) uint8_t GZ_Process(GZ_Band_t *b, float x)
+{
+    uint8_t done = 0;
+
+    b->acc += x;
+    if (++b->acc_n < b->decim)
+        return 0;
+    x = b->acc / b->decim;
+    b->acc = 0.0f;
+    b->acc_n = 0;
+
+    // 第二组在第一组的半块处开始，之后两组交替完成
+    if (b->running < b->phases && b->n[0] == b->block / 2)
+    {
+        b->dc[1] = b->dc_acc[0] / b->n[0]; // 尚无上一块，用已输入部分的均值
+        b->running++;
+    }
+    for (uint8_t ph = 0; ph < b->running; ph++)
+        done |= gz_phase_step(b, ph, x);
+    return done;
+}
@@ -0,0 +1,54 @@
+#ifndef GOERTZEL_H
+#define GOERTZEL_H
+
+#include "stdint.h"
+
+/*
+ * 频带功率跟踪：在[f_lo, f_hi]内按等间隔放置若干Goertzel频点，频点逐样本递推，每个样本 O(频点数)
+ * 带内功率在每块结束时更新，不是逐样本更新；块长超过 GZ_MAX_BLOCK_S 时(低频频带需要更细的分辨率)
+ * 用 GZ_PHASES 组频点错开半块交替完成，功率至少每 GZ_MAX_BLOCK_S 更新一次，块长不超过其两倍
+ * 低频频带先按块平均抽取到约 GZ_OVERSAMPLE*f_hi，并减去上一块的均值，
+ * 否则归一化频率过小，单精度的Goertzel递推误差会淹没带内功率
+ * 每block个抽取后样本结束一块，块内输入加Hann窗，窗函数由递推振荡器生成，不需要缓冲区
+ * 频点间隔等于块长对应的分辨率 fs/block，各频点功率之和除以窗的等效噪声带宽即为带内功率，
+ * 对单音与宽带噪声都成立；功率单位为输入刻度的平方
+ * 不依赖HAL，可在主机端编译
+ */
+
+#define GZ_MAX_BINS 12        // 每个频带的最大频点数
+#define GZ_MAX_BLOCK_S 10.0f   // 功率更新间隔的上限s，即频带报警的延迟上限
+#define GZ_MIN_RESOLUTION (1.0f / GZ_MAX_BLOCK_S) // 一般频带的最小频率分辨率Hz
+#define GZ_PHASES 2            // 块长超过GZ_MAX_BLOCK_S时错开半块的频点组数
+#define GZ_OVERSAMPLE 32       // 抽取后的采样率相对频带上限的倍数
+
+typedef struct
+{
+    uint8_t bins;
+    uint16_t decim;  // 抽取倍数
+    uint16_t acc_n;  // 当前抽取平均中已累加的样本数
+    float acc;
+    uint32_t block;   // 块长，单位抽取后样本
+    uint8_t phases;   // 频点组数，1或GZ_PHASES
+    uint8_t running;  // 已开始的组数，第二组在第一组的半块处开始
+    float f_lo, f_hi;
+    float coeff[GZ_MAX_BINS]; // 2cos(2πf/fs)
+
+    /* 每组频点独立成块：减去本组上一块的均值，Hann窗 w = 0.5 - 0.5cos(2πn/block)，
+     * cos由相量逐样本旋转得到 */
+    uint32_t n[GZ_PHASES];             // 当前块内已输入的抽取后样本数
+    float dc[GZ_PHASES], dc_acc[GZ_PHASES]; // 上一块的均值与当前块的累加
+    float s1[GZ_PHASES][GZ_MAX_BINS], s2[GZ_PHASES][GZ_MAX_BINS];
+    float win_c[GZ_PHASES], win_s[GZ_PHASES];
+    float rot_c, rot_s;
+
+    float norm;     // 频点功率换算为带内功率的系数
+    float power;    // 最近完成的一块的带内功率
+    uint32_t blocks; // 已完成的块数
+} GZ_Band_t;
+
+void GZ_Init(GZ_Band_t *b, float f_lo, float f_hi, float fs); // 按频带与采样率选择分辨率、块长与频点
+uint8_t GZ_Process(GZ_Band_t *b, float x);                     // 输入一个样本，一块结束、power更新时返回1
+uint32_t GZ_BlockSamples(const GZ_Band_t *b);                  // 块长，单位输入样本
+uint32_t GZ_UpdateSamples(const GZ_Band_t *b);                 // 功率更新间隔，单位输入样本
+
+#endif // !GOERTZEL_H
@@ -0,0 +1,199 @@
+#include "welch.h"
+#include <math.h>
+#include <string.h>
+
+#define WELCH_PI 3.14159265358979
+
+/**
+ * @brief 初始化，生成周期型窗函数表
+ * @param len: 分段长度，2的幂，不超过WELCH_MAX_LEN
+ * @param fs: 输入采样率，用于功率谱密度的归一化
+ */
+void WELCH_Init(WELCH_t *w, uint16_t len, uint8_t window, float fs)
+{
+    double u = 0.0;
+
+    memset(w, 0, sizeof(WELCH_t));
+    w->len = len > WELCH_MAX_LEN ? WELCH_MAX_LEN : len;
+    w->window = window < WELCH_WIN_NUM ? window : WELCH_WIN_HANN;
+    w->hop = w->len / 2;
+    w->alpha = 1.0f;
+    FFT_Init(&w->fft, w->len);
+
+    for (uint16_t n = 0; n < w->len; n++)
+    {
+        double x = 2.0 * WELCH_PI * n / w->len;
+        double v = 1.0;
+
+        if (w->window == WELCH_WIN_HANN)
+            v = 0.5 - 0.5 * cos(x);
+        else if (w->window == WELCH_WIN_BLACKMAN)
+            v = 0.42 - 0.5 * cos(x) + 0.08 * cos(2.0 * x);
+        u += v * v;
+#if ECG_USE_FIXED_POINT
+        w->win[n] = v >= 1.0 ? INT32_MAX : (int32_t)(v * 2147483648.0);
+#else
+        w->win[n] = (float)v;
+#endif
+    }
+    w->scale = (float)(2.0 / (fs * u));
+}
+
+/**
+ * @brief 设置分段间隔与平均
+ * @param hop: 分段间隔，单位输入样本，重叠率为 1-hop/len
+ * @param avg: 指数平均的时间常数，单位分段，1时不平均
+ */
+void WELCH_Config(WELCH_t *w, uint16_t hop, uint8_t avg)
+{
+    w->hop = hop > 0 ? hop : 1;
+    w->alpha = 1.0f / (avg > 0 ? avg : 1);
+}
+
+void WELCH_Reset(WELCH_t *w)
+{
+    memset(w->ring, 0, sizeof(w->ring));
+    memset(w->psd, 0, sizeof(w->psd));
+    w->pos = 0;
+    w->count = 0;
+    w->filled = 0;
+    w->segments = 0;
+}
+
+/**
+ * @brief 输入一个样本
+ * @return 1:已积累hop个新样本且缓冲区已满，应调用WELCH_Process
+ */
+uint8_t WELCH_Push(WELCH_t *w, welch_in_t x)
+{
+    w->ring[w->pos] = x;
+    w->pos = w->pos + 1 >= w->len ? 0 : w->pos + 1;
+    if (w->filled < w->len)
+        w->filled++;
+    if (++w->count < w->hop || w->filled < w->len)
+        return 0;
+    w->count = 0;
+    return 1;
+}
+
+void WELCH_SetPeakFrom(WELCH_t *w, uint16_t bin)
+{
+    w->peak_from = bin < w->len / 2 ? bin : 0;
+}
+
+/**
+ * @brief 按时间顺序取出最近len个样本，加窗后做FFT，结果留在out中
+ */
+ECG_RAMFUNC(FFT) void WELCH_Transform(WELCH_t *w)
+{
+    uint16_t len = w->len;
+    uint16_t first = len - w->pos; // 环形缓冲区中最早的样本在pos处
+
+#if ECG_USE_FIXED_POINT
+    for (uint16_t i = 0; i < first; i++)
+        w->work[i] = (int32_t)(((int64_t)w->ring[w->pos + i] * w->win[i]) >> 31);
+    for (uint16_t i = first; i < len; i++)
+        w->work[i] = (int32_t)(((int64_t)w->ring[i - first] * w->win[i]) >> 31);
+    FFT_RealQ31(&w->fft, w->work, w->out);
+#else
+    for (uint16_t i = 0; i < first; i++)
+        w->work[i] = w->ring[w->pos + i] * w->win[i];
+    for (uint16_t i = first; i < len; i++)
+        w->work[i] = w->ring[i - first] * w->win[i];
+    FFT_Real(&w->fft, w->work, w->out);
+#endif
+}
+
+/**
+ * @brief 由FFT结果求功率谱密度，按指数平均累加，同一遍循环中搜索峰值
+ *        直流分量没有对应的负频率，单边谱中不乘2
+ */
+ECG_RAMFUNC(FFT) void WELCH_Accumulate(WELCH_t *w)
+{
+    uint16_t bins = w->len / 2;
+    float alpha = w->segments == 0 ? 1.0f : w->alpha;
+    float scale = w->scale;
+    float peak;
+    uint16_t peak_bin = w->peak_from;
+    float *pow;
+
+#if ECG_USE_FIXED_POINT
+    // arm_rfft_q31输出按1/len缩放，换算回24位刻度为 *len/256；
+    // Q31求模平方的结果只保留高位，小信号精度不够，这里转为浮点计算
+    float k = (float)w->len / 256.0f;
+
+    pow = (float *)w->work; // 加窗输入已被FFT改写，借用为功率
+    scale *= k * k;
+    pow[0] = (float)w->out[0] * (float)w->out[0];
+    for (uint16_t i = 1; i < bins; i++)
+    {
+        float re = (float)w->out[2 * i], im = (float)w->out[2 * i + 1];
+        pow[i] = re * re + im * im;
+    }
+#else
+    float dc = w->out[0];
+
+    // out[1]为奈奎斯特分量，不在输出范围内；原位求模平方后第0点单独计算
+    pow = w->out;
+    FFT_MagSquared(w->out, pow, bins);
+    pow[0] = dc * dc;
+#endif
+
+    w->psd[0] += alpha * (pow[0] * scale * 0.5f - w->psd[0]);
+    peak = w->peak_from == 0 ? w->psd[0] : -1.0f;
+    for (uint16_t i = 1; i < bins; i++)
+    {
+        float p = w->psd[i] + alpha * (pow[i] * scale - w->psd[i]);
+
+        w->psd[i] = p;
+        if (i >= w->peak_from && p > peak)
+        {
+            peak = p;
+            peak_bin = i;
+        }
+    }
+    w->max = peak > 0.0f ? peak : 0.0f;
+    w->peak_bin = peak_bin;
+    w->segments++;
+}
+
+void WELCH_Process(WELCH_t *w)
+{
+    WELCH_Transform(w);
+    WELCH_Accumulate(w);
+}
+
+/**
+ * @brief 把功率谱压缩到屏幕上的列，每列取所含各点的最大值，再按显示刻度换算
+ *        开方与对数只对每列计算一次
+ * @param out: columns个输出，相对 peak_from 及以上的最大值归一化到0~1，
+ *             以下的直流与基线漂移超出时限幅为1，不会把整个谱压扁
+ * @param columns: 列数，不超过len/2，0时每点一列
+ * @param view: 显示刻度，见 WELCH_VIEW_xxx
+ */
+void WELCH_View(const WELCH_t *w, float *out, uint16_t columns, uint8_t view)
+{
+    uint16_t bins = w->len / 2;
+    float inv = w->max > 0.0f ? 1.0f / w->max : 0.0f;
+    uint16_t i = 0;
+
+    if (columns == 0 || columns > bins)
+        columns = bins;
+    for (uint16_t c = 0; c < columns; c++)
+    {
+        uint16_t end = (uint16_t)((uint32_t)(c + 1) * bins / columns);
+        float p = w->psd[i];
+
+        for (i++; i < end; i++)
+        {
+            if (w->psd[i] > p)
+                p = w->psd[i];
+        }
+        p *= inv;
+        if (view == WELCH_VIEW_AMPLITUDE)
+            p = sqrtf(p);
+        else if (view == WELCH_VIEW_DB)
+            p = p > 0.0f ? 1.0f + 10.0f * log10f(p) / WELCH_VIEW_DB_RANGE : 0.0f;
+        out[c] = p > 0.0f ? (p < 1.0f ? p : 1.0f) : 0.0f;
+    }
+}
@@ -0,0 +1,78 @@
+#ifndef WELCH_H
+#define WELCH_H
+
+#include "stdint.h"
+#include "ecg_conf.h"
+#include "ecg_fft.h"
+
+/*
+ * Welch功率谱估计：输入样本逐个写入环形缓冲区，每hop个样本取最近len点加窗做一次FFT，
+ * 得到的周期图按指数平均累加到功率谱密度上
+ * 重叠率 = 1 - hop/len，窗函数表在初始化时生成
+ * 输出为单边功率谱密度，单位为 输入刻度^2/Hz，输入刻度为24位样本
+ * 定点模式下加窗与FFT为Q31，平均在浮点中进行
+ * 求功率、平均与峰值搜索在同一遍循环中完成，不开方；
+ * 显示用的幅值或dB只对屏幕上的列计算，见 WELCH_View
+ */
+
+#define WELCH_MAX_LEN 1024
+
+/* 窗函数 */
+#define WELCH_WIN_RECT 0
+#define WELCH_WIN_HANN 1
+#define WELCH_WIN_BLACKMAN 2
+#define WELCH_WIN_NUM 3
+
+/* 显示刻度，WELCH_View 的输出都归一化到0~1 */
+#define WELCH_VIEW_POWER 0     // 功率，线性
+#define WELCH_VIEW_AMPLITUDE 1 // 幅值，功率开方
+#define WELCH_VIEW_DB 2        // dB，显示峰值以下 WELCH_VIEW_DB_RANGE
+#define WELCH_VIEW_NUM 3
+#define WELCH_VIEW_DB_RANGE 60.0f
+
+#if ECG_USE_FIXED_POINT
+typedef int32_t welch_in_t; // Q31，即24位样本左移8位
+#else
+typedef float welch_in_t;
+#endif
+
+typedef struct
+{
+    FFT_t fft;
+    uint16_t len;
+    uint16_t hop;     // 每hop个输入做一个分段
+    uint16_t pos;     // 环形缓冲区写入位置，也是最早的样本
+    uint16_t count;   // 自上个分段以来的输入数
+    uint32_t filled;  // 已输入样本数，不足len时不做分段
+    uint32_t segments; // 已平均的分段数
+    uint8_t window;
+    float alpha;       // 指数平均系数，1时不平均
+    float scale;       // 周期图换算为功率谱密度的系数 2/(fs*sum(w^2))
+    uint16_t peak_from; // 峰值搜索的起始点，跳过直流与基线漂移
+    uint16_t peak_bin;  // 平均后 peak_from 及以上的最大点
+    float max;          // 平均后 peak_from 及以上的最大值，即峰值点的功率，用于显示缩放
+#if ECG_USE_FIXED_POINT
+    int32_t win[WELCH_MAX_LEN];       // Q31窗函数
+    int32_t ring[WELCH_MAX_LEN];
+    int32_t work[WELCH_MAX_LEN];
+    int32_t out[WELCH_MAX_LEN * 2];   // arm_rfft_q31输出len个复数
+#else
+    float win[WELCH_MAX_LEN];
+    float ring[WELCH_MAX_LEN];
+    float work[WELCH_MAX_LEN];
+    float out[WELCH_MAX_LEN];         // arm_rfft_fast_f32输出
+#endif
+    float psd[WELCH_MAX_LEN / 2];     // 平均后的功率谱密度，第k点对应 k*fs/len
+} WELCH_t;
+
+void WELCH_Init(WELCH_t *w, uint16_t len, uint8_t window, float fs);   // 初始化并生成窗函数表
+void WELCH_Config(WELCH_t *w, uint16_t hop, uint8_t avg);              // 设置分段间隔与平均的分段数(时间常数)
+uint8_t WELCH_Push(WELCH_t *w, welch_in_t x);                          // 输入一个样本，有分段待处理时返回1
+void WELCH_SetPeakFrom(WELCH_t *w, uint16_t bin);                       // 设置峰值搜索的起始点
+void WELCH_Transform(WELCH_t *w);                                      // 分段第一步：加窗与FFT
+void WELCH_Accumulate(WELCH_t *w);                                     // 分段第二步：求功率、平均并搜索峰值
+void WELCH_Process(WELCH_t *w);                                        // 处理一个分段，即以上两步
+void WELCH_View(const WELCH_t *w, float *out, uint16_t columns, uint8_t view); // 按列输出归一化的显示值
+void WELCH_Reset(WELCH_t *w);                                          // 清空平均结果与输入
+
+#endif // !WELCH_H
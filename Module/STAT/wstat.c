@@ -0,0 +1,119 @@
+#include "wstat.h"
+#include "ecg_conf.h"
+#include <math.h>
+#include <string.h>
+
+/**
+ * @brief 初始化
+ * @param ring: 样本所在的环形缓冲区，调用者每次WSTAT_Push之后把同一个样本写入ring[原w->pos]
+ * @param len: 窗口长度，即ring的长度，不超过WSTAT_MAX_LEN
+ */
+void WSTAT_Init(WSTAT_t *w, const wstat_in_t *ring, uint16_t len)
+{
+    memset(w, 0, sizeof(WSTAT_t));
+    w->ring = ring;
+    w->len = len == 0 || len > WSTAT_MAX_LEN ? WSTAT_MAX_LEN : len;
+}
+
+static inline uint16_t wstat_at(const WSTAT_t *w, const WSTAT_Queue_t *q, uint16_t i)
+{
+    uint16_t k = q->head + i;
+
+    return q->pos[k >= w->len ? k - w->len : k];
+}
+
+/**
+ * @brief 新样本入队：从队尾弹出所有不可能再成为极值的样本
+ * @param greater: 1为最大值队列，0为最小值队列
+ */
+static inline void wstat_enqueue(WSTAT_t *w, WSTAT_Queue_t *q, wstat_in_t x, uint8_t greater)
+{
+    uint16_t k;
+
+    while (q->size > 0)
+    {
+        wstat_in_t back = w->ring[wstat_at(w, q, q->size - 1)];
+
+        if (greater ? back > x : back < x)
+            break;
+        q->size--;
+    }
+    k = q->head + q->size;
+    q->pos[k >= w->len ? k - w->len : k] = w->pos;
+    q->size++;
+}
+
+/**
+ * @brief 移出位置pos上的样本：它若是队首则出队
+ */
+static inline void wstat_expire(WSTAT_t *w, WSTAT_Queue_t *q, uint16_t pos)
+{
+    if (q->size > 0 && q->pos[q->head] == pos)
+    {
+        q->head = q->head + 1 >= w->len ? 0 : q->head + 1;
+        q->size--;
+    }
+}
+
+/**
+ * @brief 输入一个样本，此时ring[w->pos]仍是将被移出的最早样本
+ *        队列按原始格式比较，换算为24位刻度是单调的，极值位置不变
+ */
+ECG_RAMFUNC(WSTAT) void WSTAT_Push(WSTAT_t *w, wstat_in_t x)
+{
+    int32_t c = WSTAT_COUNTS(x);
+
+    if (w->count >= w->len)
+    {
+        int32_t old = WSTAT_COUNTS(w->ring[w->pos]);
+
+        w->sum -= old;
+        w->sum2 -= (int64_t)old * old;
+        wstat_expire(w, &w->max_q, w->pos);
+        wstat_expire(w, &w->min_q, w->pos);
+    }
+    else
+    {
+        w->count++;
+    }
+    w->sum += c;
+    w->sum2 += (int64_t)c * c;
+    wstat_enqueue(w, &w->max_q, x, 1);
+    wstat_enqueue(w, &w->min_q, x, 0);
+    w->pos = w->pos + 1 >= w->len ? 0 : w->pos + 1;
+}
+
+int32_t WSTAT_Max(const WSTAT_t *w)
+{
+    return w->max_q.size > 0 ? WSTAT_COUNTS(w->ring[w->max_q.pos[w->max_q.head]]) : 0;
+}
+
+int32_t WSTAT_Min(const WSTAT_t *w)
+{
+    return w->min_q.size > 0 ? WSTAT_COUNTS(w->ring[w->min_q.pos[w->min_q.head]]) : 0;
+}
+
+float WSTAT_Mean(const WSTAT_t *w)
+{
+    return w->count > 0 ? (float)((double)w->sum / w->count) : 0.0f;
+}
+
+/**
+ * @brief 总体标准差
+ *        先用整数均值q=sum/n把平方和换算为相对q的偏差平方和 ss = sum2 - 2q*sum + n*q^2，
+ *        在int64中精确计算(各项不超过2^58)，n*var = ss - r^2/n，r = sum - n*q 且 |r| < n，
+ *        不会出现 sum2/n - mean^2 那样大均值下的相消，浮点只用于最后的除法与开方
+ */
+float WSTAT_Std(const WSTAT_t *w)
+{
+    int64_t n = w->count, q, r, ss;
+    double var;
+
+    if (n == 0)
+        return 0.0f;
+    q = w->sum / n;
+    r = w->sum - q * n;
+    ss = w->sum2 - 2 * q * w->sum + n * q * q;
+    var = ((double)ss - (double)(r * r) / n) / n;
+    return var > 0.0 ? (float)sqrt(var) : 0.0f;
+}
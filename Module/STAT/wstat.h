@@ -0,0 +1,52 @@
+#ifndef WSTAT_H
+#define WSTAT_H
+
+#include "stdint.h"
+#include "ecg_conf.h"
+
+/*
+ * 滑动窗口统计：最近len个样本的最大值、最小值、均值与方差
+ * 样本不另存一份，直接读调用者的环形缓冲区(信号链中为Welch的ring)，本模块只保存位置与累加和
+ * 最大/最小值用单调队列维护，队列中只保留可能成为极值的样本位置，每个样本均摊O(1)
+ * 和与平方和按24位刻度用64位整数累加，移出样本时精确相减，没有累积误差
+ * 不依赖HAL，可在主机端编译
+ */
+
+#define WSTAT_MAX_LEN 1024
+
+/* 样本格式与Welch环形缓冲区相同 */
+#if ECG_USE_FIXED_POINT
+typedef int32_t wstat_in_t; // Q31，即24位样本左移8位
+#define WSTAT_COUNTS(x) ((x) >> 8)
+#else
+typedef float wstat_in_t;
+#define WSTAT_COUNTS(x) ((int32_t)(x))
+#endif
+
+typedef struct
+{
+    uint16_t head; // 队首，即窗口内最早的候选
+    uint16_t size;
+    uint16_t pos[WSTAT_MAX_LEN]; // 样本在窗口环形缓冲区中的位置
+} WSTAT_Queue_t;
+
+typedef struct
+{
+    const wstat_in_t *ring; // 调用者的环形缓冲区，长度为len
+    uint16_t len;
+    uint16_t pos;   // 下一个写入位置，窗口已满时也是最早的样本
+    uint16_t count; // 窗口内样本数
+    int64_t sum;
+    int64_t sum2;
+    WSTAT_Queue_t max_q; // 值单调递减
+    WSTAT_Queue_t min_q; // 值单调递增
+} WSTAT_t;
+
+void WSTAT_Init(WSTAT_t *w, const wstat_in_t *ring, uint16_t len); // 初始化，ring的写入位置须同时从0开始
+void WSTAT_Push(WSTAT_t *w, wstat_in_t x); // 在x写入ring[w->pos]之前调用，窗口满时移出该位置上最早的样本
+int32_t WSTAT_Max(const WSTAT_t *w);       // 窗口内最大值，24位刻度，窗口为空时为0
+int32_t WSTAT_Min(const WSTAT_t *w);       // 窗口内最小值，24位刻度，窗口为空时为0
+float WSTAT_Mean(const WSTAT_t *w);        // 均值
+float WSTAT_Std(const WSTAT_t *w);         // 总体标准差
+
+#endif // !WSTAT_H
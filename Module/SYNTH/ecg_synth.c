@@ -0,0 +1,188 @@
+#include "ecg_synth.h"
+#include "ads1292r_frame.h"
+#include <math.h>
+#include <string.h>
+
+#define SYNTH_PI 3.14159265f
+#define SYNTH_SUBSTEPS 4       // 每个样本内的积分步数
+#define SYNTH_Z_SCALE 24.0f    // z换算为mV，使R波约1mV
+#define SYNTH_MOTION_TAU 0.3f  // 运动伪迹衰减时间常数，s
+#define SYNTH_GAIN 6.0f        // ADS1292R PGA增益(CHnSET=0x00)
+#define SYNTH_VREF 2.42f       // 内部参考电压
+
+/* P Q R S T 的相位、幅值与宽度 */
+static const float synth_theta[5] = {-SYNTH_PI / 3.0f, -SYNTH_PI / 12.0f, 0.0f, SYNTH_PI / 12.0f, SYNTH_PI / 2.0f};
+static const float synth_a[5] = {1.2f, -5.0f, 30.0f, -7.5f, 0.75f};
+static const float synth_b[5] = {0.25f, 0.1f, 0.1f, 0.1f, 0.4f};
+
+/**
+ * @brief xorshift32，返回[0,1)均匀分布
+ */
+static float synth_uniform(SYNTH_t *s)
+{
+    s->rng ^= s->rng << 13;
+    s->rng ^= s->rng >> 17;
+    s->rng ^= s->rng << 5;
+    return (s->rng >> 8) * (1.0f / 16777216.0f);
+}
+
+/**
+ * @brief Box-Muller 标准正态分布
+ */
+static float synth_gauss(SYNTH_t *s)
+{
+    float u1 = synth_uniform(s) + 1e-7f;
+    float u2 = synth_uniform(s);
+    return sqrtf(-2.0f * logf(u1)) * cosf(2.0f * SYNTH_PI * u2);
+}
+
+/**
+ * @brief 生成下一个RR间期：LF与HF两个正弦调制加少量随机抖动，总标准差为hrv_std
+ */
+static float synth_next_rr(SYNTH_t *s)
+{
+    float rr_mean = 60.0f / s->p.hr_mean;
+    float lf = sqrtf(s->p.lf_hf / (1.0f + s->p.lf_hf));
+    float hf = sqrtf(1.0f / (1.0f + s->p.lf_hf));
+    float v = 0.9f * 1.41421356f * (lf * sinf(s->lf_phase) + hf * sinf(s->hf_phase)) + 0.43f * synth_gauss(s);
+    float rr = rr_mean + s->p.hrv_std * v;
+
+    if (rr < 0.25f) // 不超过240bpm
+        rr = 0.25f;
+    return rr;
+}
+
+void SYNTH_DefaultParam(SYNTH_Param_t *p, float fs)
+{
+    memset(p, 0, sizeof(SYNTH_Param_t));
+    p->fs = fs;
+    p->hr_mean = 60.0f;
+    p->hrv_std = 0.0f;
+    p->lf_hf = 0.5f;
+    p->mains_freq = 50.0f;
+    p->resp_freq = 0.25f;
+    p->seed = 1;
+}
+
+/**
+ * @brief 基准负载：72bpm，含HRV、工频、噪声与基线漂移
+ *        固件的BENCH命令与主机测试共用，两边的耗时对应同一信号
+ */
+void SYNTH_BenchParam(SYNTH_Param_t *p, float fs)
+{
+    SYNTH_DefaultParam(p, fs);
+    p->hr_mean = 72.0f;
+    p->hrv_std = 0.04f;
+    p->mains_amp = 0.1f;
+    p->wander_amp = 0.2f;
+    p->noise_std = 0.02f;
+}
+
+void SYNTH_Init(SYNTH_t *s, const SYNTH_Param_t *p)
+{
+    memset(s, 0, sizeof(SYNTH_t));
+    s->p = *p;
+    s->dt = 1.0f / p->fs;
+    s->rng = p->seed ? p->seed : 1;
+    s->theta = -SYNTH_PI; // 从舒张期开始
+    s->lf_phase = 2.0f * SYNTH_PI * synth_uniform(s);
+    s->hf_phase = 2.0f * SYNTH_PI * synth_uniform(s);
+    s->rr = synth_next_rr(s);
+    s->omega = 2.0f * SYNTH_PI / s->rr;
+    s->motion_decay = expf(-s->dt / SYNTH_MOTION_TAU);
+}
+
+/**
+ * @brief 输出下一个样本
+ * @return ECG，mV
+ */
+float SYNTH_Next(SYNTH_t *s)
+{
+    float h = s->dt / SYNTH_SUBSTEPS;
+    float z0 = s->p.wander_amp * sinf(2.0f * SYNTH_PI * s->p.resp_freq * s->t);
+    float y;
+
+    for (uint8_t k = 0; k < SYNTH_SUBSTEPS; k++)
+    {
+        float dz = 0.0f;
+        float prev = s->theta;
+
+        for (uint8_t i = 0; i < 5; i++)
+        {
+            float d = s->theta - synth_theta[i];
+            d -= 2.0f * SYNTH_PI * floorf((d + SYNTH_PI) / (2.0f * SYNTH_PI)); // 折算到[-π,π)
+            dz -= synth_a[i] * d * expf(-0.5f * d * d / (synth_b[i] * synth_b[i]));
+        }
+        // 乘以 ω/2π 使波形幅值不随心率变化
+        s->z += h * (dz * s->omega * (0.5f / SYNTH_PI) - s->z);
+        s->theta += h * s->omega;
+
+        if (prev < 0.0f && s->theta >= 0.0f) // 经过R波，按下一个RR间期转到下一个R波
+        {
+            s->r_sample = s->n;
+            s->beats++;
+            s->rr = synth_next_rr(s);
+            s->omega = 2.0f * SYNTH_PI / s->rr;
+        }
+        if (s->theta >= SYNTH_PI)
+            s->theta -= 2.0f * SYNTH_PI;
+    }
+
+    s->lf_phase += 2.0f * SYNTH_PI * 0.1f * s->dt;
+    s->hf_phase += 2.0f * SYNTH_PI * s->p.resp_freq * s->dt;
+    s->mains_phase += 2.0f * SYNTH_PI * s->p.mains_freq * s->dt;
+    if (s->lf_phase > 2.0f * SYNTH_PI)
+        s->lf_phase -= 2.0f * SYNTH_PI;
+    if (s->hf_phase > 2.0f * SYNTH_PI)
+        s->hf_phase -= 2.0f * SYNTH_PI;
+    if (s->mains_phase > 2.0f * SYNTH_PI)
+        s->mains_phase -= 2.0f * SYNTH_PI;
+
+    // 运动伪迹：按发生率随机出现的阶跃，之后指数衰减
+    s->motion *= s->motion_decay;
+    if (s->p.motion_rate > 0.0f && synth_uniform(s) < s->p.motion_rate * s->dt)
+        s->motion += s->p.motion_amp * (2.0f * synth_uniform(s) - 1.0f);
+
+    // 基线漂移在z换算为mV之后叠加，否则z跟踪z0的滞后会被放大SYNTH_Z_SCALE倍
+    y = SYNTH_Z_SCALE * s->z + z0;
+    y += s->p.mains_amp * sinf(s->mains_phase);
+    y += s->motion;
+    if (s->p.noise_std > 0.0f)
+        y += s->p.noise_std * synth_gauss(s);
+
+    s->t += s->dt;
+    s->n++;
+    return y;
+}
+
+/**
+ * @brief mV换算为ADS1292R码值，超出量程时限幅
+ */
+int32_t SYNTH_ToCounts(float mv)
+{
+    float v = mv * 0.001f * SYNTH_GAIN / SYNTH_VREF * 8388608.0f;
+
+    if (v > ADS1292R_FULL_SCALE_POS)
+        return ADS1292R_FULL_SCALE_POS;
+    if (v < ADS1292R_FULL_SCALE_NEG)
+        return ADS1292R_FULL_SCALE_NEG;
+    return (int32_t)v;
+}
+
+/**
+ * @brief 输出一帧ADS1292R原始数据，状态字为1100且无导联脱落
+ */
+void SYNTH_Frame(SYNTH_t *s, uint8_t *raw)
+{
+    int32_t ch1 = SYNTH_ToCounts(SYNTH_Next(s));
+
+    raw[0] = 0xC0;
+    raw[1] = 0x00;
+    raw[2] = 0x00;
+    raw[3] = (uint8_t)(ch1 >> 16);
+    raw[4] = (uint8_t)(ch1 >> 8);
+    raw[5] = (uint8_t)ch1;
+    raw[6] = 0x00;
+    raw[7] = 0x00;
+    raw[8] = 0x00;
+}
@@ -0,0 +1,55 @@
+#ifndef ECG_SYNTH_H
+#define ECG_SYNTH_H
+
+#include "stdint.h"
+
+/*
+ * 合成ECG信号(McSharry动力学模型)：相位在极限环上匀速转动，
+ * P/Q/R/S/T 五个高斯核驱动z，z即ECG波形
+ * 叠加心率变异(LF/HF两个频带)、白噪声、工频干扰、基线漂移与运动伪迹
+ * 不依赖HAL，主机端用于驱动基准测试，固件中可经DAC输出做硬件在环测试
+ */
+
+typedef struct
+{
+    float fs;          // 采样率，Hz
+    float hr_mean;     // 平均心率，bpm
+    float hrv_std;     // RR间期标准差，s
+    float lf_hf;       // HRV中LF(0.1Hz)与HF(呼吸频率)功率之比
+    float noise_std;   // 白噪声标准差，mV
+    float mains_amp;   // 工频干扰幅值，mV
+    float mains_freq;  // 工频，50或60Hz
+    float wander_amp;  // 基线漂移幅值，mV
+    float resp_freq;   // 呼吸频率，Hz，同时决定基线漂移与HF频带
+    float motion_rate; // 运动伪迹平均发生率，次/s
+    float motion_amp;  // 运动伪迹幅值，mV
+    uint32_t seed;     // 随机数种子，相同种子得到相同信号
+} SYNTH_Param_t;
+
+typedef struct
+{
+    SYNTH_Param_t p;
+    float dt;
+    float t;          // 当前时间，s
+    float theta;      // 极限环相位，R波在0处
+    float omega;      // 角速度，2π/RR
+    float z;          // ECG分量，未缩放
+    float rr;         // 当前RR间期，s
+    float lf_phase, hf_phase;
+    float mains_phase;
+    float motion;     // 当前运动伪迹偏移，mV
+    float motion_decay;
+    uint32_t rng;
+    uint32_t n;       // 已输出样本数
+    uint32_t r_sample; // 最近一个R波的样本序号
+    uint32_t beats;    // R波计数
+} SYNTH_t;
+
+void SYNTH_DefaultParam(SYNTH_Param_t *p, float fs);    // 60bpm、无干扰的默认参数
+void SYNTH_BenchParam(SYNTH_Param_t *p, float fs);      // 基准负载：72bpm，含HRV、工频、噪声与基线漂移
+void SYNTH_Init(SYNTH_t *s, const SYNTH_Param_t *p);    // 初始化
+float SYNTH_Next(SYNTH_t *s);                           // 输出下一个样本，mV
+int32_t SYNTH_ToCounts(float mv);                       // mV换算为ADS1292R(PGA=6)的24位码值
+void SYNTH_Frame(SYNTH_t *s, uint8_t *raw);             // 输出一帧ADS1292R原始数据，CH1为ECG，CH2为0
+
+#endif // !ECG_SYNTH_H
@@ -0,0 +1,123 @@
+#include "ecg_test.h"
+#include "ecg_cmd.h"
+#include "ads1292r_frame.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define ECG_TEST_ENTRY(name, desc) {#name, desc, test_##name},
+static const struct
+{
+    const char *name;
+    const char *desc;
+    void (*run)(void);
+} test_list[] = {ECG_TESTS(ECG_TEST_ENTRY)};
+#undef ECG_TEST_ENTRY
+
+uint8_t test_bench = 0;
+uint32_t test_failed = 0;
+
+void test_check(int ok, const char *expr, const char *file, int line)
+{
+    if (ok)
+        return;
+    test_failed++;
+    printf("  FAIL %s:%d: %s\n", file, line, expr);
+}
+
+double test_now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/**
+ * @brief 生成n帧ADS1292R原始数据
+ * @param beats: 输出合成的R波数，可为NULL
+ */
+uint8_t *test_synth_frames(const SYNTH_Param_t *p, uint32_t n, uint32_t *beats)
+{
+    uint8_t *frames = malloc((size_t)n * ADS1292R_FRAME_SIZE);
+    SYNTH_t s;
+
+    SYNTH_Init(&s, p);
+    for (uint32_t i = 0; i < n; i++)
+        SYNTH_Frame(&s, frames + (size_t)i * ADS1292R_FRAME_SIZE);
+    if (beats != NULL)
+        *beats = s.beats;
+    return frames;
+}
+
+/**
+ * @brief 当前构建的FIR内核，输入输出都为24位刻度
+ */
+double test_fir_kernel(FIR_t *fir, int32_t x)
+{
+#if !ECG_USE_FIXED_POINT
+    return FIR_filter(fir, (float)x);
+#elif !ECG_FIR_Q15
+    return FIR_filter_q31(fir, (int32_t)((uint32_t)x << 8)) / 256.0;
+#else
+    return FIR_filter_q15(fir, (int16_t)(((int32_t)((uint32_t)x << 8)) >> 16)) * 256.0;
+#endif
+}
+
+double test_snr_db(const double *ref, const double *x, uint32_t n)
+{
+    double sig = 0.0, err = 0.0;
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        sig += ref[i] * ref[i];
+        err += (x[i] - ref[i]) * (x[i] - ref[i]);
+    }
+    return err > 0.0 ? 10.0 * log10(sig / err) : 999.0;
+}
+
+/**
+ * @brief 用法：ecg_test [-b] [用例名...]，不带用例名时运行全部
+ */
+int main(int argc, char **argv)
+{
+    ECG_Config_t config = ecg_config;
+    uint32_t total = 0, failed_cases = 0;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-b") == 0)
+            test_bench = 1;
+    }
+
+    for (size_t k = 0; k < sizeof(test_list) / sizeof(test_list[0]); k++)
+    {
+        uint8_t selected = 1;
+
+        for (int i = 1; i < argc; i++)
+        {
+            if (argv[i][0] == '-')
+                continue;
+            selected = strcmp(argv[i], test_list[k].name) == 0;
+            if (selected)
+                break;
+        }
+        if (!selected)
+            continue;
+
+        // 每个用例从默认配置与清零的计数器开始
+        ecg_config = config;
+        ecg_config.telemetry = 0;
+        memset(&ecg_counter, 0, sizeof(ecg_counter));
+        test_failed = 0;
+        printf("%s: %s\n", test_list[k].name, test_list[k].desc);
+        test_list[k].run();
+        printf("%s %s\n", test_failed ? "FAIL" : "PASS", test_list[k].name);
+        total++;
+        failed_cases += test_failed != 0;
+    }
+
+    printf("%u/%u passed\n", total - failed_cases, total);
+    return failed_cases != 0;
+}
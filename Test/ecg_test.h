@@ -0,0 +1,49 @@
+#ifndef ECG_TEST_H
+#define ECG_TEST_H
+
+#include "stdint.h"
+#include "ecg_synth.h"
+#include "FIR.h"
+#include <stdio.h>
+
+/*
+ * 主机端测试与基准，链接 build/host/<profile>/<variant>/libecgdsp.a
+ *   make test   三种信号链(float/q31/q15)各运行一遍全部用例，检查失败时返回非0
+ *   make bench  同一程序加 -b，数据加长，输出的耗时即为提交说明中的数字
+ *   make bench-profiles  debug(-Og)与release(-O2, fast-math)两种优化下的内核耗时
+ * 用例返回前用 TEST_CHECK 检查结果，用 TEST_LOG 输出 "用例 指标=值" 形式的测量结果
+ * 耗时为主机上的ns，固件上的周期数用 BENCH 命令测量
+ */
+
+/* 用例列表，新增用例只需在此添加并实现 test_<name>() */
+#define ECG_TESTS(X) \
+    X(core, "合成ECG经过整条信号链的心拍数与心率") \
+    X(fixed, "当前信号链FIR相对双精度参考的SNR与每样本耗时") \
+    X(unpack, "批量帧解析与逐字节解析一致，及每帧耗时") \
+    X(qrs, "QRS检测在不同心率与干扰下的敏感度/阳性预测值，及每样本耗时") \
+    X(prof, "BENCH命令的信号链基准：每样本总耗时与各阶段平均耗时") \
+    X(spectrum, "不同抽取倍数下频谱峰值的搜索起点与报告的频率，及显示的归一化") \
+    X(iir, "双二阶IIR预设相对FIR的每样本耗时与群延迟，及频率响应") \
+    X(lms, "合成ECG叠加49.3/50/50.4Hz工频时LMS的频率跟踪、残差与信号链报告的干扰幅值") \
+    X(welch, "单遍求功率、平均与峰值搜索相对分开多遍的每帧耗时") \
+    X(band, "频带功率跟踪对单音的误差与功率更新间隔(报警延迟)") \
+    X(hrv, "长时间RR序列(基准模式24h)的HRV：每心拍与每步耗时，SDNN与LF/HF功率") \
+    X(wstat, "滑动窗口统计与逐点扫描一致，大直流偏置下的标准差，抽取后的峰峰值，及各显示模式下的遥测")
+
+#define ECG_TEST_DECL(name, desc) void test_##name(void);
+ECG_TESTS(ECG_TEST_DECL)
+#undef ECG_TEST_DECL
+
+extern uint8_t test_bench; // 1:基准模式，数据加长
+extern uint32_t test_failed; // 当前用例失败的检查数
+
+#define TEST_CHECK(cond) test_check((cond), #cond, __FILE__, __LINE__)
+#define TEST_LOG(...) printf("  " __VA_ARGS__)
+
+void test_check(int ok, const char *expr, const char *file, int line);
+double test_now(void);                                    // 单调时钟，单位ns
+uint8_t *test_synth_frames(const SYNTH_Param_t *p, uint32_t n, uint32_t *beats); // 生成n帧原始数据，需free
+double test_snr_db(const double *ref, const double *x, uint32_t n); // x相对ref的信噪比
+double test_fir_kernel(FIR_t *fir, int32_t x);            // 当前构建的FIR内核，输入输出为24位刻度
+
+#endif // !ECG_TEST_H
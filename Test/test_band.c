@@ -0,0 +1,72 @@
+#include "ecg_test.h"
+#include "goertzel.h"
+#include "ecg_cmd.h"
+#include <math.h>
+
+#define BAND_TEST_FS 500.0f
+#define BAND_TEST_AMP 20000.0  // 单音幅值，24位刻度
+#define BAND_TEST_DC 3000000.0 // 直流偏置
+#define BAND_TEST_DRIFT 5000.0 // 0.03Hz基线漂移幅值
+
+/**
+ * @brief 直流偏置与慢漂移上叠加单音，返回第一块之后每次更新的RMS相对单音RMS的最大误差，%
+ * @param update_ms: 输出相邻两次功率更新的最大间隔
+ */
+static double test_band_error(const uint16_t range[2], double f, uint32_t *update_ms)
+{
+    GZ_Band_t b;
+    uint32_t n = (uint32_t)(BAND_TEST_FS * 120);
+    uint32_t last = 0, gap = 0;
+    double worst = 0.0;
+
+    GZ_Init(&b, range[0] * 0.1f, range[1] * 0.1f, BAND_TEST_FS);
+    for (uint32_t i = 0; i < n; i++)
+    {
+        double t = i / BAND_TEST_FS;
+        double x = BAND_TEST_DC + BAND_TEST_DRIFT * sin(2.0 * M_PI * 0.03 * t) +
+                   BAND_TEST_AMP * sin(2.0 * M_PI * f * t + 0.3);
+
+        if (!GZ_Process(&b, (float)x))
+            continue;
+        if (b.blocks > b.phases) // 每组的第一块没有上一块的均值可减
+        {
+            double err = 100.0 * (sqrt(b.power) / (BAND_TEST_AMP / sqrt(2.0)) - 1.0);
+
+            if (fabs(err) > fabs(worst))
+                worst = err;
+            if (i - last > gap)
+                gap = i - last;
+        }
+        last = i;
+    }
+    *update_ms = (uint32_t)(gap * 1000.0f / BAND_TEST_FS);
+    return worst;
+}
+
+/**
+ * @brief 默认频带内单音的功率误差与功率更新间隔(即报警延迟)：
+ *        工频、心率与呼吸频带中部在0.5%以内，20s块长的呼吸频带也至少每GZ_MAX_BLOCK_S更新一次
+ */
+void test_band(void)
+{
+    static const struct
+    {
+        uint8_t band;
+        double f;
+        double tol; // %
+    } cases[] = {
+        {ECG_BAND_MAINS, 50.0, 0.5}, {ECG_BAND_MAINS, 49.7, 0.5}, {ECG_BAND_HR, 1.2, 0.5},
+        {ECG_BAND_HR, 2.5, 0.5},     {ECG_BAND_RESP, 0.2, 0.5},   {ECG_BAND_RESP, 0.25, 0.5},
+    };
+
+    for (size_t k = 0; k < sizeof(cases) / sizeof(cases[0]); k++)
+    {
+        uint32_t update_ms;
+        double err = test_band_error(ecg_config.band[cases[k].band], cases[k].f, &update_ms);
+
+        TEST_LOG("band=%u f=%.2f update_ms=%u worst_err_pct=%.2f\n", cases[k].band, cases[k].f, update_ms, err);
+        TEST_CHECK(fabs(err) < cases[k].tol);
+        TEST_CHECK(update_ms <= (uint32_t)(GZ_MAX_BLOCK_S * 1000.0f) + 100); // 抽取平均的取整
+        TEST_CHECK(update_ms > 0);
+    }
+}
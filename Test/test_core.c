@@ -0,0 +1,37 @@
+#include "ecg_test.h"
+#include "ecg_core.h"
+#include "ecg_cmd.h"
+#include "ecg_port_host.h"
+#include "ads1292r_frame.h"
+#include <stdlib.h>
+
+/**
+ * @brief 60s合成ECG(基准模式10min)经过整条信号链：
+ *        检出的心拍数只允许少于合成数(学习期)，心率与合成的72bpm一致，并给出每样本耗时
+ */
+void test_core(void)
+{
+    uint32_t seconds = test_bench ? 600 : 60;
+    uint32_t n = 500 * seconds;
+    uint32_t beats;
+    SYNTH_Param_t p;
+    uint8_t *frames;
+    double t0, t1;
+
+    SYNTH_BenchParam(&p, 500.0f);
+    frames = test_synth_frames(&p, n, &beats);
+
+    ECG_Core_Init(ECG_HostPort_Init(frames, n, NULL));
+    t0 = test_now();
+    while (ECG_Core_Poll())
+        ;
+    t1 = test_now();
+
+    TEST_LOG("synth_beats=%u core_beats=%u hr=%u fft=%u ns_per_sample=%.0f\n", beats, ecg_counter.beats,
+             ECG_HostPort_Get()->heart_rate, ecg_counter.fft_frames, (t1 - t0) / n);
+    TEST_CHECK(ecg_counter.samples == n);
+    TEST_CHECK(ecg_counter.beats <= beats && ecg_counter.beats + 3 >= beats);
+    TEST_CHECK(ECG_HostPort_Get()->heart_rate >= 70 && ECG_HostPort_Get()->heart_rate <= 74);
+    TEST_CHECK(ecg_counter.fft_frames > 0);
+    free(frames);
+}
@@ -0,0 +1,55 @@
+#include "ecg_test.h"
+#include "FIR.h"
+#include <stdlib.h>
+
+/*
+ * 定点信号链的精度：合成ECG的24位样本分别经过当前构建的FIR内核(float/Q31/Q15)
+ * 与双精度卷积，比较两者输出，SNR随 make test 的三种构建分别给出
+ */
+
+#define TEST_FIXED_SKIP FIR_MAX_TAPS // 跳过历史未填满的输出
+
+void test_fixed(void)
+{
+    uint32_t n = test_bench ? 500 * 600 : 500 * 20;
+    const FIR_Design_t *design = FIR_Bank_Find(FIR_MODE_LEGACY, 500);
+    int32_t *x = malloc(n * sizeof(int32_t));
+    double *ref = calloc(n, sizeof(double));
+    double *y = malloc(n * sizeof(double));
+    SYNTH_Param_t p;
+    SYNTH_t s;
+    FIR_t *fir = malloc(sizeof(FIR_t));
+    double t0, t1, snr;
+
+    SYNTH_BenchParam(&p, 500.0f);
+    SYNTH_Init(&s, &p);
+    for (uint32_t i = 0; i < n; i++)
+        x[i] = SYNTH_ToCounts(SYNTH_Next(&s));
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        for (uint16_t k = 0; k < design->taps && k <= i; k++)
+            ref[i] += (double)design->coeffs[k] * x[i - k];
+    }
+
+    FIR_Init(fir, design);
+    t0 = test_now();
+    for (uint32_t i = 0; i < n; i++)
+        y[i] = test_fir_kernel(fir, x[i]);
+    t1 = test_now();
+
+    snr = test_snr_db(ref + TEST_FIXED_SKIP, y + TEST_FIXED_SKIP, n - TEST_FIXED_SKIP);
+    TEST_LOG("fixed=%d q15=%d taps=%u snr_db=%.1f ns_per_sample=%.1f\n", ECG_USE_FIXED_POINT, ECG_FIR_Q15,
+             design->taps, snr, (t1 - t0) / n);
+#if !ECG_USE_FIXED_POINT
+    TEST_CHECK(snr > 100.0);
+#elif !ECG_FIR_Q15
+    TEST_CHECK(snr > 100.0);
+#else
+    TEST_CHECK(snr > 20.0); // 输入只保留24位样本的高16位，1mV的ECG只有约80个Q15刻度
+#endif
+    free(x);
+    free(ref);
+    free(y);
+    free(fir);
+}
@@ -0,0 +1,88 @@
+#include "ecg_test.h"
+#include "hrv.h"
+#include <math.h>
+#include <stdlib.h>
+
+/*
+ * 长时间RR序列：800ms均值上叠加0.1Hz(LF)与0.25Hz(HF)正弦调制，
+ * 幅值30ms与20ms，对应频带功率 450ms² 与 200ms²
+ * 时刻从接近2^32ms处开始，覆盖回绕
+ */
+
+#define HRV_TEST_RR 800.0
+#define HRV_TEST_LF_AMP 30.0
+#define HRV_TEST_HF_AMP 20.0
+#define HRV_TEST_STEPS 20 // 每个心拍之间调用HRV_Step的次数，模拟空闲时间
+
+/**
+ * @brief 窗口内NN的样本标准差，直接重新计算
+ */
+static double test_hrv_sdnn(const HRV_t *hrv)
+{
+    double mean = 0.0, var = 0.0;
+
+    for (uint16_t i = 0; i < hrv->count; i++)
+        mean += hrv->beat[(hrv->head + i) % HRV_MAX_BEATS].rr;
+    mean /= hrv->count;
+    for (uint16_t i = 0; i < hrv->count; i++)
+    {
+        double d = hrv->beat[(hrv->head + i) % HRV_MAX_BEATS].rr - mean;
+        var += d * d;
+    }
+    return sqrt(var / (hrv->count - 1));
+}
+
+void test_hrv(void)
+{
+    double hours = test_bench ? 24.0 : 1.0;
+    HRV_t *hrv = malloc(sizeof(HRV_t));
+    uint32_t t = 0xFFFFFFFFu - 600000u; // 10分钟后回绕
+    double ts = 0.0, add_ns = 0.0, step_ns = 0.0, worst_sdnn = 0.0;
+    uint32_t beats = 0, steps = 0;
+    HRV_Time_t time;
+
+    HRV_Init(hrv, HRV_WINDOW_MAX_S);
+    TEST_CHECK(HRV_Step(hrv) == 0); // 空窗口
+
+    while (ts < hours * 3600.0)
+    {
+        double rr = HRV_TEST_RR + HRV_TEST_LF_AMP * sin(2.0 * M_PI * 0.1 * ts) +
+                    HRV_TEST_HF_AMP * sin(2.0 * M_PI * 0.25 * ts);
+        double t0, t1;
+
+        ts += rr * 0.001;
+        t += (uint32_t)lround(rr);
+        t0 = test_now();
+        HRV_AddBeat(hrv, t);
+        t1 = test_now();
+        add_ns += t1 - t0;
+        beats++;
+
+        t0 = test_now();
+        for (int i = 0; i < HRV_TEST_STEPS; i++)
+            HRV_Step(hrv);
+        t1 = test_now();
+        step_ns += t1 - t0;
+        steps += HRV_TEST_STEPS;
+
+        if (beats % 1000 == 0 && hrv->count > 1)
+        {
+            double d;
+
+            HRV_GetTime(hrv, &time);
+            d = fabs(time.sdnn - test_hrv_sdnn(hrv));
+            if (d > worst_sdnn)
+                worst_sdnn = d;
+        }
+    }
+
+    HRV_GetTime(hrv, &time);
+    TEST_LOG("hours=%.0f beats=%u add_ns=%.0f step_ns=%.0f spectra=%u lf=%.1f hf=%.1f sdnn=%.2f sdnn_err=%.4f\n",
+             hours, beats, add_ns / beats, step_ns / steps, hrv->spectra, hrv->lf, hrv->hf, time.sdnn, worst_sdnn);
+    TEST_CHECK(hrv->rejected == 0);
+    TEST_CHECK(hrv->spectra > 0);
+    TEST_CHECK(fabs(hrv->lf - 450.0) < 450.0 * 0.05);
+    TEST_CHECK(fabs(hrv->hf - 200.0) < 200.0 * 0.05);
+    TEST_CHECK(worst_sdnn < 0.01);
+    free(hrv);
+}
@@ -0,0 +1,146 @@
+#include "ecg_test.h"
+#include "iir.h"
+#include <math.h>
+#include <stdlib.h>
+
+/*
+ * 双二阶IIR与FIR的对比：同一段合成ECG上每样本耗时，以及1Hz/10Hz处的群延迟
+ * 同时检查预设的频率响应，以及当前构建的实现(浮点DF2T或Q31 DF1)相对双精度参考的SNR
+ */
+
+#define IIR_TEST_FS 500.0f
+#define IIR_TEST_AMP 1000000.0 // 正弦幅值，24位刻度
+
+/**
+ * @brief 当前构建的IIR内核，输入输出都为24位刻度，与信号链一致
+ */
+static double test_iir_kernel(IIR_t *iir, int32_t x)
+{
+#if ECG_USE_FIXED_POINT
+    return IIR_ProcessQ31(iir, (int32_t)((uint32_t)x << 8)) / 256.0;
+#else
+    return IIR_Process(iir, (float)x);
+#endif
+}
+
+/**
+ * @brief 双精度DF1参考，系数取自同一个IIR_t，只比较实现的舍入误差
+ */
+static void test_iir_reference(const IIR_t *iir, const int32_t *x, double *y, uint32_t n)
+{
+    double d[IIR_MAX_STAGES][4] = {{0.0}};
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        double v = x[i];
+
+        for (uint8_t s = 0; s < iir->stages; s++)
+        {
+            double out = IIR_Coeff(iir, s, 0) * v + IIR_Coeff(iir, s, 1) * d[s][0] + IIR_Coeff(iir, s, 2) * d[s][1] +
+                         IIR_Coeff(iir, s, 3) * d[s][2] + IIR_Coeff(iir, s, 4) * d[s][3];
+
+            d[s][1] = d[s][0];
+            d[s][0] = v;
+            d[s][3] = d[s][2];
+            d[s][2] = out;
+            v = out;
+        }
+        y[i] = v;
+    }
+}
+
+/**
+ * @brief 频率f的正弦经过预设后的稳态增益，dB
+ */
+static double test_iir_gain(uint8_t preset, double f)
+{
+    IIR_t iir;
+    uint32_t n = (uint32_t)(IIR_TEST_FS * 40), settle = n / 2;
+    double in = 0.0, out = 0.0;
+
+    IIR_Init(&iir, preset, IIR_TEST_FS);
+    for (uint32_t i = 0; i < n; i++)
+    {
+        double x = IIR_TEST_AMP * sin(2.0 * M_PI * f * i / IIR_TEST_FS);
+        double y = test_iir_kernel(&iir, (int32_t)lround(x));
+
+        if (i >= settle)
+        {
+            in += x * x;
+            out += y * y;
+        }
+    }
+    return 10.0 * log10(out / in + 1e-30);
+}
+
+void test_iir(void)
+{
+    static const uint8_t presets[] = {IIR_PRESET_NOTCH50, IIR_PRESET_HP, IIR_PRESET_HP_NOTCH50};
+    uint32_t n = test_bench ? 500 * 600 : 500 * 20;
+    int32_t *x = malloc(n * sizeof(int32_t));
+    double *yr = malloc(n * sizeof(double));
+    double *yk = malloc(n * sizeof(double));
+    FIR_t *fir = malloc(sizeof(FIR_t));
+    double sink = 0.0, t0, t1, fir_ns;
+    SYNTH_Param_t p;
+    SYNTH_t s;
+
+    SYNTH_BenchParam(&p, IIR_TEST_FS);
+    SYNTH_Init(&s, &p);
+    for (uint32_t i = 0; i < n; i++)
+        x[i] = SYNTH_ToCounts(SYNTH_Next(&s));
+
+    FIR_Init(fir, FIR_Bank_Find(FIR_MODE_LEGACY, 500));
+    t0 = test_now();
+    for (uint32_t i = 0; i < n; i++)
+        sink += test_fir_kernel(fir, x[i]);
+    t1 = test_now();
+    fir_ns = (t1 - t0) / n;
+    TEST_LOG("fir taps=%u delay=%u ns_per_sample=%.1f\n", fir->design->taps, FIR_Delay(fir), fir_ns);
+
+    for (size_t k = 0; k < sizeof(presets); k++)
+    {
+        IIR_t iir;
+        double snr;
+
+        IIR_Init(&iir, presets[k], IIR_TEST_FS);
+        t0 = test_now();
+        for (uint32_t i = 0; i < n; i++)
+            sink += test_iir_kernel(&iir, x[i]);
+        t1 = test_now();
+
+        // 当前构建的内核与双精度参考逐点比较
+        IIR_Init(&iir, presets[k], IIR_TEST_FS);
+        for (uint32_t i = 0; i < n; i++)
+            yk[i] = test_iir_kernel(&iir, x[i]);
+        test_iir_reference(&iir, x, yr, n);
+        snr = test_snr_db(yr, yk, n);
+
+        TEST_LOG("preset=%u stages=%u ns_per_sample=%.1f delay_1hz=%.1f delay_10hz=%.1f snr_db=%.1f\n",
+                 presets[k], iir.stages, (t1 - t0) / n, IIR_GroupDelay(&iir, 1.0f, IIR_TEST_FS),
+                 IIR_GroupDelay(&iir, 10.0f, IIR_TEST_FS), snr);
+        TEST_CHECK(fabsf(IIR_GroupDelay(&iir, 10.0f, IIR_TEST_FS)) < FIR_Delay(fir));
+        TEST_CHECK(snr > 70.0); // 0.5Hz极点附近两种实现的舍入噪声都约为-80dB
+    }
+
+    {
+        double notch = test_iir_gain(IIR_PRESET_NOTCH50, 50.0);
+        double notch_pass = test_iir_gain(IIR_PRESET_NOTCH50, 10.0);
+        double hp_fc = test_iir_gain(IIR_PRESET_HP, 0.5);
+        double hp_pass = test_iir_gain(IIR_PRESET_HP, 10.0);
+
+        TEST_LOG("notch50_db=%.1f notch_10hz_db=%.2f hp_0.5hz_db=%.2f hp_10hz_db=%.2f\n", notch, notch_pass, hp_fc,
+                 hp_pass);
+        TEST_CHECK(notch < -40.0);
+        TEST_CHECK(fabs(notch_pass) < 0.1);
+        TEST_CHECK(fabs(hp_fc + 3.0) < 0.3);
+        TEST_CHECK(fabs(hp_pass) < 0.1);
+    }
+
+    if (sink == 1.0) // 防止计时循环被优化掉
+        TEST_LOG("\n");
+    free(x);
+    free(yr);
+    free(yk);
+    free(fir);
+}
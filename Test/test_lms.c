@@ -0,0 +1,106 @@
+#include "ecg_test.h"
+#include "lms.h"
+#include "ecg_core.h"
+#include "ecg_cmd.h"
+#include "ecg_port_host.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define LMS_TEST_FS 500.0f
+#define LMS_TEST_MAINS_MV 0.3f // 工频干扰幅值
+
+/**
+ * @brief 合成ECG叠加工频，LMS去除前后相对无干扰信号的残差RMS(mV)与跟踪到的频率
+ *        两路合成使用同一种子，只差工频一项
+ */
+static void test_lms_run(float mains_freq, uint32_t n, double *before, double *after, float *freq)
+{
+    double scale = LMS_TEST_MAINS_MV / (SYNTH_ToCounts(LMS_TEST_MAINS_MV) - SYNTH_ToCounts(0.0f)); // mV/刻度
+    double e0 = 0.0, e1 = 0.0;
+    SYNTH_Param_t p, q;
+    SYNTH_t noisy, clean;
+    LMS_t lms;
+
+    SYNTH_BenchParam(&p, LMS_TEST_FS);
+    p.mains_amp = LMS_TEST_MAINS_MV;
+    p.mains_freq = mains_freq;
+    q = p;
+    q.mains_amp = 0.0f;
+    SYNTH_Init(&noisy, &p);
+    SYNTH_Init(&clean, &q);
+    LMS_Init(&lms, 50.0f, 1, LMS_TEST_FS, 0.001f, 200.0f); // 与信号链相同的参数
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        int32_t x = SYNTH_ToCounts(SYNTH_Next(&noisy));
+        int32_t ref = SYNTH_ToCounts(SYNTH_Next(&clean));
+        float y = LMS_Process(&lms, (float)x);
+
+        if (i >= n / 2) // 后一半为收敛后的稳态
+        {
+            e0 += (double)(x - ref) * (x - ref);
+            e1 += ((double)y - ref) * ((double)y - ref);
+        }
+    }
+    *before = sqrt(e0 / (n - n / 2)) * scale;
+    *after = sqrt(e1 / (n - n / 2)) * scale;
+    *freq = lms.freq;
+}
+
+/**
+ * @brief 经过整条信号链时遥测报告的干扰幅值，24位刻度
+ */
+static long test_lms_core_amp(uint32_t n)
+{
+    SYNTH_Param_t p;
+    uint8_t *frames;
+    FILE *tlm = tmpfile();
+    char line[64];
+    long amp = -1;
+
+    SYNTH_BenchParam(&p, LMS_TEST_FS);
+    p.mains_amp = LMS_TEST_MAINS_MV;
+    frames = test_synth_frames(&p, n, NULL);
+    ecg_config.mains = 50;
+    ecg_config.telemetry = ECG_TLM_MAINS;
+    ECG_Core_Init(ECG_HostPort_Init(frames, n, tlm));
+    while (ECG_Core_Poll())
+        ;
+    rewind(tlm);
+    while (fgets(line, sizeof(line), tlm) != NULL)
+    {
+        if (strncmp(line, "{mains_amp}", 11) == 0)
+            amp = strtol(line + 11, NULL, 10);
+    }
+    fclose(tlm);
+    free(frames);
+    return amp;
+}
+
+/**
+ * @brief 工频在标称值与偏离标称值时的跟踪精度与残差，以及信号链报告的干扰幅值
+ */
+void test_lms(void)
+{
+    static const float freqs[] = {49.3f, 50.0f, 50.4f};
+    uint32_t n = (uint32_t)LMS_TEST_FS * (test_bench ? 600 : 60);
+    long expect = SYNTH_ToCounts(LMS_TEST_MAINS_MV) - SYNTH_ToCounts(0.0f);
+    long amp;
+
+    for (size_t k = 0; k < sizeof(freqs) / sizeof(freqs[0]); k++)
+    {
+        double before, after;
+        float freq;
+
+        test_lms_run(freqs[k], n, &before, &after, &freq);
+        TEST_LOG("mains=%.1f tracked=%.4f residual_before_mv=%.4f residual_after_mv=%.4f\n", freqs[k], freq, before,
+                 after);
+        TEST_CHECK(fabsf(freq - freqs[k]) < 0.005f);
+        TEST_CHECK(after < before / 50.0);
+    }
+
+    amp = test_lms_core_amp(n);
+    TEST_LOG("core mains_amp=%ld expect=%ld\n", amp, expect);
+    TEST_CHECK(labs(amp - expect) < expect / 20);
+}
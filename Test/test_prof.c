@@ -0,0 +1,40 @@
+#include "ecg_test.h"
+#include "ecg_core.h"
+#include "ecg_cmd.h"
+#include "ecg_prof.h"
+#include "ecg_port_host.h"
+
+#define PROF_ZONE_NAME(id, name) name,
+static const char *const prof_name[PROF_ZONE_NUM] = {ECG_PROF_ZONES(PROF_ZONE_NAME)};
+#undef PROF_ZONE_NAME
+
+/**
+ * @brief ECG_Core_Bench(即固件的BENCH命令)在主机上的运行结果：每样本总耗时与各阶段平均耗时
+ *        固件上对比 DSP_CCM/RAMFUNC 等构建选项时，用同样的样本数执行 BENCH 命令
+ */
+void test_prof(void)
+{
+    uint32_t samples = test_bench ? 50000 : 5000;
+    uint32_t ticks;
+
+    ECG_Core_Init(ECG_HostPort_Init(NULL, 0, NULL));
+    ticks = ECG_Core_Bench(samples);
+
+    TEST_LOG("samples=%u ns_per_sample=%.0f\n", samples, (double)ticks / samples);
+    for (int z = 0; z < PROF_ZONE_NUM; z++)
+    {
+        const PROF_Stat_t *s = PROF_GetStat((PROF_Zone_e)z);
+
+        if (s->count != 0)
+            TEST_LOG("%s count=%u mean_ns=%.0f max_ns=%u\n", prof_name[z], s->count, (double)s->sum / s->count,
+                     s->max);
+    }
+    TEST_CHECK(ticks > 0);
+#if ECG_PROF_ENABLE
+    TEST_CHECK(PROF_GetStat(PROF_IIR)->count == samples);
+    TEST_CHECK(PROF_GetStat(PROF_LMS)->count == samples);
+    TEST_CHECK(PROF_GetStat(PROF_QRS)->count > 0);
+    TEST_CHECK(PROF_GetStat(PROF_PRINTF)->count == 0); // 基准关闭遥测，printf区间不记空样本
+#endif
+    TEST_CHECK(ecg_config.display_mode != ECG_DISPLAY_OFF); // 配置已恢复
+}
@@ -0,0 +1,147 @@
+#include "ecg_test.h"
+#include "ecg_core.h"
+#include "ecg_cmd.h"
+#include "ecg_port_host.h"
+#include "ads1292r_frame.h"
+#include "qrs.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * QRS检测的评分：合成ECG的R波时刻作为标注，经过整条信号链(检测支路FIR+QRS)，
+ * 用 r_peak 遥测(已扣除群延迟)与标注按±150ms配对，统计敏感度Se与阳性预测值PPV
+ * 前 TEST_QRS_SKIP_S 秒为检测器的学习期，不计分
+ */
+
+#define TEST_QRS_TOL_S 0.15f
+#define TEST_QRS_SKIP_S 3
+#define TEST_QRS_MAX_BEATS 20000
+
+typedef struct
+{
+    const char *name;
+    float hr;
+    float noise;  // 白噪声，mV
+    float motion; // 运动伪迹发生率，次/s，幅值0.5mV
+} TEST_QRS_Case_t;
+
+static uint32_t test_qrs_det[TEST_QRS_MAX_BEATS];
+static uint32_t test_qrs_det_num;
+
+static void test_qrs_telemetry(const char *name, long value)
+{
+    if (strcmp(name, "r_peak") == 0 && test_qrs_det_num < TEST_QRS_MAX_BEATS)
+        test_qrs_det[test_qrs_det_num++] = (uint32_t)value;
+}
+
+/**
+ * @brief 标注与检出按时间顺序配对，一个检出只配一个标注
+ * @param tp: 配对成功数
+ * @param ref_num/det_num: 计分区间内的标注数与检出数
+ */
+static void test_qrs_score(const uint32_t *ref, uint32_t ref_n, const uint32_t *det, uint32_t det_n, uint32_t skip,
+                           uint32_t tol, uint32_t *tp, uint32_t *ref_num, uint32_t *det_num)
+{
+    uint32_t j = 0;
+
+    *tp = *ref_num = *det_num = 0;
+    for (uint32_t i = 0; i < det_n; i++)
+        *det_num += det[i] >= skip;
+    for (uint32_t i = 0; i < ref_n; i++)
+    {
+        if (ref[i] < skip)
+            continue;
+        (*ref_num)++;
+        while (j < det_n && det[j] + tol < ref[i])
+            j++;
+        if (j < det_n && det[j] <= ref[i] + tol)
+        {
+            (*tp)++;
+            j++;
+        }
+    }
+}
+
+void test_qrs(void)
+{
+    static const TEST_QRS_Case_t cases[] = {
+        {"hr72", 72.0f, 0.02f, 0.0f},
+        {"hr45", 45.0f, 0.02f, 0.0f},
+        {"hr150", 150.0f, 0.02f, 0.0f},
+        {"noise", 72.0f, 0.08f, 0.0f},
+        {"motion", 72.0f, 0.02f, 0.2f},
+    };
+    const float fs = 500.0f;
+    uint32_t seconds = test_bench ? 3600 : 120;
+    uint32_t n = (uint32_t)fs * seconds;
+    uint8_t *frames = malloc((size_t)n * ADS1292R_FRAME_SIZE);
+    uint32_t *ref = malloc(TEST_QRS_MAX_BEATS * sizeof(uint32_t));
+    float *x = malloc(n * sizeof(float));
+    QRS_t *qrs = malloc(sizeof(QRS_t));
+    uint32_t tp_all = 0, ref_all = 0, det_all = 0;
+    double exact = 0.0, t0, t1;
+
+    for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++)
+    {
+        SYNTH_Param_t p;
+        SYNTH_t s;
+        ECG_Port_t port;
+        uint32_t ref_n = 0, tp, ref_num, det_num;
+
+        SYNTH_BenchParam(&p, fs);
+        p.hr_mean = cases[c].hr;
+        p.noise_std = cases[c].noise;
+        p.motion_rate = cases[c].motion;
+        p.motion_amp = 0.5f;
+        p.seed = 1 + (uint32_t)c;
+        SYNTH_Init(&s, &p);
+        for (uint32_t i = 0; i < n; i++)
+        {
+            uint32_t beats = s.beats;
+
+            SYNTH_Frame(&s, frames + (size_t)i * ADS1292R_FRAME_SIZE);
+            if (s.beats != beats && ref_n < TEST_QRS_MAX_BEATS)
+                ref[ref_n++] = s.r_sample;
+        }
+
+        port = *ECG_HostPort_Init(frames, n, NULL);
+        port.telemetry = test_qrs_telemetry;
+        ecg_config.telemetry = ECG_TLM_QRS;
+        test_qrs_det_num = 0;
+        ECG_Core_Init(&port);
+        while (ECG_Core_Poll())
+            ;
+
+        test_qrs_score(ref, ref_n, test_qrs_det, test_qrs_det_num, TEST_QRS_SKIP_S * (uint32_t)fs,
+                       (uint32_t)(TEST_QRS_TOL_S * fs), &tp, &ref_num, &det_num);
+        TEST_LOG("%-6s beats=%u tp=%u fn=%u fp=%u se=%.2f%% ppv=%.2f%%\n", cases[c].name, ref_num, tp,
+                 ref_num - tp, det_num - tp, 100.0 * tp / ref_num, det_num ? 100.0 * tp / det_num : 0.0);
+        TEST_CHECK(tp * 100 >= ref_num * 99);
+        TEST_CHECK(tp * 100 >= det_num * 99);
+        tp_all += tp;
+        ref_all += ref_num;
+        det_all += det_num;
+    }
+    TEST_LOG("total  beats=%u se=%.2f%% ppv=%.2f%%\n", ref_all, 100.0 * tp_all / ref_all, 100.0 * tp_all / det_all);
+
+    // 检测器单独的耗时，输入为最后一组的原始样本；同时检查长记录后滑动积分和没有漂移
+    for (uint32_t i = 0; i < n; i++)
+        x[i] = (float)(int32_t)(((uint32_t)frames[(size_t)i * ADS1292R_FRAME_SIZE + 3] << 24 |
+                                  (uint32_t)frames[(size_t)i * ADS1292R_FRAME_SIZE + 4] << 16 |
+                                  (uint32_t)frames[(size_t)i * ADS1292R_FRAME_SIZE + 5] << 8)) / 256.0f;
+    QRS_Init(qrs, fs);
+    t0 = test_now();
+    for (uint32_t i = 0; i < n; i++)
+        QRS_Process(qrs, x[i]);
+    t1 = test_now();
+    for (uint16_t i = 0; i < qrs->mwi_len; i++)
+        exact += qrs->mwi_buf[i];
+    TEST_LOG("qrs ns_per_sample=%.1f mwi_sum=%.6g exact=%.6g\n", (t1 - t0) / n, qrs->mwi_sum, exact);
+    TEST_CHECK(fabs(qrs->mwi_sum - exact) <= 1e-4 * exact + 1e-3);
+
+    free(frames);
+    free(ref);
+    free(x);
+    free(qrs);
+}
@@ -0,0 +1,109 @@
+#include "ecg_test.h"
+#include "ecg_core.h"
+#include "ecg_cmd.h"
+#include "ecg_port_host.h"
+#include "ads1292r_frame.h"
+#include "welch.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SPECTRUM_FS 500
+#define SPECTRUM_SECONDS 30
+#define SPECTRUM_LOW_HZ 3.0   // 峰值搜索起点以下的强分量，mV
+#define SPECTRUM_LOW_MV 1.0
+#define SPECTRUM_TONE_HZ 10.0 // 应报告的峰值频率
+#define SPECTRUM_TONE_MV 0.3
+
+/**
+ * @brief 3Hz强分量加10Hz弱分量的原始帧
+ */
+static uint8_t *spectrum_frames(uint32_t n)
+{
+    uint8_t *frames = calloc(n, ADS1292R_FRAME_SIZE);
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        double t = (double)i / SPECTRUM_FS;
+        int32_t ch1 = SYNTH_ToCounts((float)(SPECTRUM_LOW_MV * sin(2.0 * M_PI * SPECTRUM_LOW_HZ * t) +
+                                             SPECTRUM_TONE_MV * sin(2.0 * M_PI * SPECTRUM_TONE_HZ * t)));
+        uint8_t *raw = frames + (size_t)i * ADS1292R_FRAME_SIZE;
+
+        raw[0] = 0xC0;
+        raw[3] = (uint8_t)(ch1 >> 16);
+        raw[4] = (uint8_t)(ch1 >> 8);
+        raw[5] = (uint8_t)ch1;
+    }
+    return frames;
+}
+
+/**
+ * @brief 带直流偏置的10Hz正弦：显示按峰值搜索范围内的最大值归一化，10Hz所在列为1而不是被直流压扁
+ */
+static void test_spectrum_view(void)
+{
+    WELCH_t *w = malloc(sizeof(WELCH_t));
+    float view[WELCH_MAX_LEN / 2];
+    float fs = SPECTRUM_FS / 2.0f;
+    uint16_t bins = WELCH_MAX_LEN / 2;
+    uint16_t tone = (uint16_t)lround(SPECTRUM_TONE_HZ * WELCH_MAX_LEN / fs);
+
+    WELCH_Init(w, WELCH_MAX_LEN, WELCH_WIN_HANN, fs);
+    WELCH_SetPeakFrom(w, (uint16_t)ceil(6.0 * WELCH_MAX_LEN / fs));
+    for (uint32_t i = 0; i < 4 * WELCH_MAX_LEN; i++)
+    {
+        double x = 2000000.0 + 100000.0 * sin(2.0 * M_PI * SPECTRUM_TONE_HZ * i / fs);
+#if ECG_USE_FIXED_POINT
+        if (WELCH_Push(w, (int32_t)lround(x) * 256))
+#else
+        if (WELCH_Push(w, (float)x))
+#endif
+            WELCH_Process(w);
+    }
+    WELCH_View(w, view, 0, WELCH_VIEW_POWER);
+
+    TEST_LOG("view peak_bin=%u tone_bin=%u view_tone=%.3f view_dc=%.3f\n", w->peak_bin, tone, view[tone], view[0]);
+    TEST_CHECK(abs((int)w->peak_bin - (int)tone) <= 1);
+    TEST_CHECK(w->max == w->psd[w->peak_bin]);
+    TEST_CHECK(view[w->peak_bin] == 1.0f);
+    TEST_CHECK(view[0] == 1.0f); // 直流远大于峰值，限幅
+    for (uint16_t i = 0; i < bins; i++)
+        TEST_CHECK(view[i] >= 0.0f && view[i] <= 1.0f);
+    free(w);
+}
+
+/**
+ * @brief 各抽取倍数下报告的频谱峰值频率：起始频点按Hz换算，6Hz以下的强分量被跳过，
+ *        报告的频率与抽取倍数无关
+ */
+void test_spectrum(void)
+{
+    static const uint8_t decims[] = {1, 2, 4};
+    uint32_t n = SPECTRUM_FS * SPECTRUM_SECONDS;
+    uint8_t *frames = spectrum_frames(n);
+
+    for (size_t k = 0; k < sizeof(decims); k++)
+    {
+        FILE *tlm = tmpfile();
+        char line[64];
+        long freq = -1;
+
+        ecg_config.decim = decims[k];
+        ecg_config.telemetry = ECG_TLM_FREQ;
+        ECG_Core_Init(ECG_HostPort_Init(frames, n, tlm));
+        while (ECG_Core_Poll())
+            ;
+        rewind(tlm);
+        while (fgets(line, sizeof(line), tlm) != NULL)
+        {
+            if (strncmp(line, "{frequency}", 11) == 0)
+                freq = strtol(line + 11, NULL, 10);
+        }
+        fclose(tlm);
+
+        TEST_LOG("decim=%u frequency=%ld\n", decims[k], freq);
+        TEST_CHECK(labs(freq - (long)SPECTRUM_TONE_HZ) <= 1); // 遥测取整，1024点时频点间隔不超过0.5Hz
+    }
+    free(frames);
+    test_spectrum_view();
+}
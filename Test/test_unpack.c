@@ -0,0 +1,105 @@
+#include "ecg_test.h"
+#include "ads1292r_frame.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define TEST_UNPACK_BATCH 32 // 每批帧数，对应一次DMA传输
+
+/**
+ * @brief 逐字节解析的参考实现，与原 ecg_data_process 的做法相同
+ */
+static void test_unpack_ref(const uint8_t *raw, int32_t *ch1, int32_t *ch2, uint32_t *status)
+{
+    uint32_t a = ((uint32_t)raw[3] << 16) | ((uint32_t)raw[4] << 8) | raw[5];
+    uint32_t b = ((uint32_t)raw[6] << 16) | ((uint32_t)raw[7] << 8) | raw[8];
+
+    *status = ((uint32_t)raw[0] << 16) | ((uint32_t)raw[1] << 8) | raw[2];
+    *ch1 = a & 0x800000 ? (int32_t)a - 0x1000000 : (int32_t)a;
+    *ch2 = b & 0x800000 ? (int32_t)b - 0x1000000 : (int32_t)b;
+}
+
+static void test_unpack_put24(uint8_t *p, int32_t v)
+{
+    p[0] = (uint8_t)(v >> 16);
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)v;
+}
+
+void test_unpack(void)
+{
+    static const int32_t edge[] = {0, 1, -1, ADS1292R_FULL_SCALE_POS, ADS1292R_FULL_SCALE_NEG, 0x123456, -0x123456};
+    uint32_t frames = test_bench ? 1u << 20 : 1u << 14;
+    uint32_t n = frames * ADS1292R_FRAME_SIZE;
+    uint8_t *buf = malloc(n + 1); // 多1字节，从奇地址开始再测一遍非对齐
+    int32_t ch1[TEST_UNPACK_BATCH], ch2[TEST_UNPACK_BATCH];
+    uint32_t status[TEST_UNPACK_BATCH];
+    uint32_t mismatch = 0, rng = 1;
+    volatile int32_t sink = 0;
+    ADS1292R_Sample_t sample;
+    double t0, t_batch, t_ref;
+
+    for (uint32_t i = 0; i < n + 1; i++)
+    {
+        rng ^= rng << 13;
+        rng ^= rng >> 17;
+        rng ^= rng << 5;
+        buf[i] = (uint8_t)rng;
+    }
+    for (uint32_t i = 0; i < sizeof(edge) / sizeof(edge[0]); i++)
+    {
+        test_unpack_put24(buf + i * ADS1292R_FRAME_SIZE + 3, edge[i]);
+        test_unpack_put24(buf + i * ADS1292R_FRAME_SIZE + 6, -edge[i] - 1);
+    }
+
+    for (uint8_t offset = 0; offset < 2; offset++)
+    {
+        const uint8_t *raw = buf + offset;
+
+        for (uint32_t i = 0; i + TEST_UNPACK_BATCH <= frames; i += TEST_UNPACK_BATCH)
+        {
+            ADS1292R_UnpackFrames(raw + i * ADS1292R_FRAME_SIZE, TEST_UNPACK_BATCH, ch1, ch2, status);
+            for (uint32_t k = 0; k < TEST_UNPACK_BATCH; k++)
+            {
+                int32_t r1, r2;
+                uint32_t rs;
+
+                test_unpack_ref(raw + (i + k) * ADS1292R_FRAME_SIZE, &r1, &r2, &rs);
+                mismatch += r1 != ch1[k] || r2 != ch2[k] || rs != status[k];
+            }
+        }
+    }
+    TEST_CHECK(mismatch == 0);
+
+    // 单帧解析：状态字头、导联脱落与满幅标志
+    memcpy(buf, (const uint8_t[]){0xC0, 0x00, 0x00, 0x7f, 0xff, 0xff, 0x80, 0x00, 0x00}, ADS1292R_FRAME_SIZE);
+    ADS1292R_ParseFrame(buf, &sample);
+    TEST_CHECK(sample.ch[0] == ADS1292R_FULL_SCALE_POS && sample.ch[1] == ADS1292R_FULL_SCALE_NEG);
+    TEST_CHECK(sample.flags == (ADS1292R_FLAG_SAT_CH1 | ADS1292R_FLAG_SAT_CH2));
+    memcpy(buf, (const uint8_t[]){0xC8, 0x00, 0x00, 0x00, 0x10, 0x00, 0xff, 0xff, 0xf0}, ADS1292R_FRAME_SIZE);
+    ADS1292R_ParseFrame(buf, &sample);
+    TEST_CHECK(sample.ch[0] == 0x1000 && sample.ch[1] == -16);
+    TEST_CHECK(sample.flags == ADS1292R_FLAG_LEAD_OFF);
+    buf[0] = 0x40;
+    ADS1292R_ParseFrame(buf, &sample);
+    TEST_CHECK(sample.flags & ADS1292R_FLAG_SYNC_ERR);
+
+    t0 = test_now();
+    for (uint32_t i = 0; i + TEST_UNPACK_BATCH <= frames; i += TEST_UNPACK_BATCH)
+    {
+        ADS1292R_UnpackFrames(buf + i * ADS1292R_FRAME_SIZE, TEST_UNPACK_BATCH, ch1, ch2, status);
+        sink += ch1[0] + ch2[TEST_UNPACK_BATCH - 1];
+    }
+    t_batch = test_now() - t0;
+    t0 = test_now();
+    for (uint32_t i = 0; i + TEST_UNPACK_BATCH <= frames; i += TEST_UNPACK_BATCH)
+    {
+        for (uint32_t k = 0; k < TEST_UNPACK_BATCH; k++)
+            test_unpack_ref(buf + (i + k) * ADS1292R_FRAME_SIZE, &ch1[k], &ch2[k], &status[k]);
+        sink += ch1[0] + ch2[TEST_UNPACK_BATCH - 1];
+    }
+    t_ref = test_now() - t0;
+    (void)sink;
+    TEST_LOG("frames=%u batch=%u mismatch=%u batch_ns_per_frame=%.2f bytewise_ns_per_frame=%.2f\n", frames,
+             TEST_UNPACK_BATCH, mismatch, t_batch / frames, t_ref / frames);
+    free(buf);
+}
@@ -0,0 +1,128 @@
+#include "ecg_test.h"
+#include "welch.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Welch分段第二步的耗时：单遍的 WELCH_Accumulate 与分开的求功率/平均、最大值扫描、峰值扫描比较
+ * 两者对同一FFT结果计算，功率谱与峰值点必须完全相同
+ */
+
+#define WELCH_TEST_FS 250.0f // 500SPS抽取2倍
+
+static volatile float welch_sink; // 参考实现的全谱最大值，防止扫描被优化掉
+
+/**
+ * @brief 分开多遍的参考实现，与合并前的做法相同
+ */
+static void welch_separate(WELCH_t *w)
+{
+    uint16_t bins = w->len / 2;
+    float alpha = w->segments == 0 ? 1.0f : w->alpha;
+    float scale = w->scale;
+    float max, peak = -1.0f;
+    uint16_t peak_bin = w->peak_from;
+    float *pow;
+
+#if ECG_USE_FIXED_POINT
+    float k = (float)w->len / 256.0f;
+
+    pow = (float *)w->work;
+    scale *= k * k;
+    pow[0] = (float)w->out[0] * (float)w->out[0];
+    for (uint16_t i = 1; i < bins; i++)
+    {
+        float re = (float)w->out[2 * i], im = (float)w->out[2 * i + 1];
+        pow[i] = re * re + im * im;
+    }
+#else
+    float dc = w->out[0];
+
+    pow = w->out;
+    FFT_MagSquared(w->out, pow, bins);
+    pow[0] = dc * dc;
+#endif
+
+    w->psd[0] += alpha * (pow[0] * scale * 0.5f - w->psd[0]);
+    for (uint16_t i = 1; i < bins; i++)
+        w->psd[i] += alpha * (pow[i] * scale - w->psd[i]);
+
+    max = w->psd[0];
+    for (uint16_t i = 1; i < bins; i++)
+    {
+        if (w->psd[i] > max)
+            max = w->psd[i];
+    }
+    if (w->peak_from == 0)
+        peak = w->psd[0];
+    for (uint16_t i = w->peak_from > 0 ? w->peak_from : 1; i < bins; i++)
+    {
+        if (w->psd[i] > peak)
+        {
+            peak = w->psd[i];
+            peak_bin = i;
+        }
+    }
+    w->max = peak > 0.0f ? peak : 0.0f;
+    w->peak_bin = peak_bin;
+    w->segments++;
+    welch_sink = max;
+}
+
+void test_welch(void)
+{
+    uint32_t frames = test_bench ? 20000 : 2000;
+    WELCH_t *a = malloc(sizeof(WELCH_t));
+    WELCH_t *b = malloc(sizeof(WELCH_t));
+    void *out = malloc(sizeof(a->out));
+    SYNTH_Param_t p;
+    SYNTH_t s;
+    double t0, t1, fused, separate;
+
+    SYNTH_BenchParam(&p, WELCH_TEST_FS);
+    SYNTH_Init(&s, &p);
+    WELCH_Init(a, WELCH_MAX_LEN, WELCH_WIN_HANN, WELCH_TEST_FS);
+    WELCH_Config(a, WELCH_MAX_LEN / 2, 4);
+    WELCH_SetPeakFrom(a, (uint16_t)ceil(6.0 * WELCH_MAX_LEN / WELCH_TEST_FS));
+    for (uint32_t i = 0; i < WELCH_MAX_LEN; i++)
+    {
+        int32_t x = SYNTH_ToCounts(SYNTH_Next(&s));
+#if ECG_USE_FIXED_POINT
+        WELCH_Push(a, (int32_t)((uint32_t)x << 8));
+#else
+        WELCH_Push(a, (float)x);
+#endif
+    }
+    WELCH_Transform(a);
+    memcpy(out, a->out, sizeof(a->out));
+    memcpy(b, a, sizeof(WELCH_t));
+
+    // 每帧先恢复FFT结果，两边的拷贝开销相同
+    t0 = test_now();
+    for (uint32_t f = 0; f < frames; f++)
+    {
+        memcpy(a->out, out, sizeof(a->out));
+        WELCH_Accumulate(a);
+    }
+    t1 = test_now();
+    fused = (t1 - t0) / frames;
+
+    t0 = test_now();
+    for (uint32_t f = 0; f < frames; f++)
+    {
+        memcpy(b->out, out, sizeof(b->out));
+        welch_separate(b);
+    }
+    t1 = test_now();
+    separate = (t1 - t0) / frames;
+
+    TEST_LOG("bins=%u fused_ns_per_frame=%.0f separate_ns_per_frame=%.0f saved_ns=%.0f peak_bin=%u\n",
+             WELCH_MAX_LEN / 2, fused, separate, separate - fused, a->peak_bin);
+    TEST_CHECK(memcmp(a->psd, b->psd, sizeof(a->psd)) == 0);
+    TEST_CHECK(a->peak_bin == b->peak_bin);
+    TEST_CHECK(a->max == b->max);
+    free(a);
+    free(b);
+    free(out);
+}
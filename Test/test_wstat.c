@@ -0,0 +1,196 @@
+#include "ecg_test.h"
+#include "wstat.h"
+#include "fir_decim.h"
+#include "ecg_core.h"
+#include "ecg_cmd.h"
+#include "ecg_port_host.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * 滑动窗口统计与逐点扫描窗口的参考结果比较，样本从调用者的环形缓冲区读取
+ * 另测大直流偏置下标准差的精度，抽取后的窗口相对全速率的峰峰值，
+ * 以及各显示模式下信号链都输出窗口统计与频率遥测
+ */
+
+#define WSTAT_TEST_LEN 1024
+
+static WSTAT_t wstat_test;
+static wstat_in_t wstat_ring[WSTAT_TEST_LEN];
+static FIR_Decim_t wstat_decim;
+
+static wstat_in_t wstat_from_counts(int32_t c)
+{
+#if ECG_USE_FIXED_POINT
+    return (int32_t)((uint32_t)c << 8);
+#else
+    return (float)c;
+#endif
+}
+
+/**
+ * @brief 与信号链相同的用法：先更新统计，再写入环形缓冲区
+ */
+static void wstat_push(int32_t c)
+{
+    wstat_in_t x = wstat_from_counts(c);
+    uint16_t pos = wstat_test.pos;
+
+    WSTAT_Push(&wstat_test, x);
+    wstat_ring[pos] = x;
+}
+
+/**
+ * @brief 逐点扫描窗口，双精度两遍求均值与标准差
+ */
+static void wstat_reference(int32_t *max, int32_t *min, double *mean, double *std)
+{
+    uint16_t n = wstat_test.count;
+    double sum = 0.0, dev = 0.0;
+
+    *max = INT32_MIN;
+    *min = INT32_MAX;
+    for (uint16_t i = 0; i < n; i++)
+    {
+        int32_t c = WSTAT_COUNTS(wstat_ring[i]);
+
+        *max = c > *max ? c : *max;
+        *min = c < *min ? c : *min;
+        sum += c;
+    }
+    *mean = sum / n;
+    for (uint16_t i = 0; i < n; i++)
+    {
+        double d = WSTAT_COUNTS(wstat_ring[i]) - *mean;
+        dev += d * d;
+    }
+    *std = sqrt(dev / n);
+}
+
+/**
+ * @brief 随机样本，含连续相等的值与接近满量程的值，每个样本后与参考比较
+ */
+static uint32_t wstat_check_random(uint32_t n)
+{
+    uint32_t mismatch = 0, seed = 12345;
+    int32_t c = 0;
+
+    WSTAT_Init(&wstat_test, wstat_ring, WSTAT_TEST_LEN);
+    for (uint32_t i = 0; i < n; i++)
+    {
+        int32_t max, min;
+        double mean, std;
+
+        seed = seed * 1664525u + 1013904223u;
+        if ((seed >> 28) != 0) // 约1/16的样本重复上一个值
+            c = (int32_t)(seed >> 8) - (1 << 23);
+        wstat_push(c);
+        if (i % 7 != 0 && i + 1 != n)
+            continue;
+        wstat_reference(&max, &min, &mean, &std);
+        mismatch += WSTAT_Max(&wstat_test) != max || WSTAT_Min(&wstat_test) != min ||
+                    fabs(WSTAT_Mean(&wstat_test) - mean) > 1e-6 * fabs(mean) + 0.5 ||
+                    fabs(WSTAT_Std(&wstat_test) - std) > 1e-6 * std + 1e-3;
+    }
+    return mismatch;
+}
+
+/**
+ * @brief 同一段合成ECG在三种显示模式下经过信号链，统计频率与峰峰值遥测的行数
+ */
+static void wstat_check_modes(void)
+{
+    uint32_t n = 500 * 30;
+    uint8_t *frames;
+    uint32_t count[ECG_DISPLAY_OFF + 1][2] = {{0}};
+    SYNTH_Param_t p;
+
+    SYNTH_BenchParam(&p, 500.0f);
+    frames = test_synth_frames(&p, n, NULL);
+    for (uint8_t mode = ECG_DISPLAY_ALL; mode <= ECG_DISPLAY_OFF; mode++)
+    {
+        FILE *tlm = tmpfile();
+        char line[64];
+
+        ecg_config.display_mode = mode;
+        ecg_config.telemetry = ECG_TLM_FREQ | ECG_TLM_STATS;
+        ECG_Core_Init(ECG_HostPort_Init(frames, n, tlm));
+        while (ECG_Core_Poll())
+            ;
+        rewind(tlm);
+        while (fgets(line, sizeof(line), tlm) != NULL)
+        {
+            count[mode][0] += strncmp(line, "{frequency}", 11) == 0;
+            count[mode][1] += strncmp(line, "{p2p}", 5) == 0;
+        }
+        fclose(tlm);
+        TEST_LOG("mode=%u frequency_lines=%u p2p_lines=%u spectrum_draws=%u\n", mode, count[mode][0], count[mode][1],
+                 ECG_HostPort_Get()->spectrum_frames);
+        TEST_CHECK(count[mode][0] > 0 && count[mode][0] == count[0][0]);
+        TEST_CHECK(count[mode][1] == count[0][0]);
+        TEST_CHECK((ECG_HostPort_Get()->spectrum_frames > 0) == (mode == ECG_DISPLAY_ALL));
+    }
+    free(frames);
+}
+
+void test_wstat(void)
+{
+    uint32_t n = test_bench ? 1000000 : 100000;
+    uint32_t mismatch = wstat_check_random(20000);
+    int32_t max, min, full_max = INT32_MIN, full_min = INT32_MAX;
+    double mean, std, naive, t0, t1;
+    SYNTH_Param_t p;
+    SYNTH_t s;
+
+    // 直流偏置接近满量程、噪声只有几个刻度时，sum2/n - mean^2 的相消最严重
+    WSTAT_Init(&wstat_test, wstat_ring, WSTAT_TEST_LEN);
+    for (uint32_t i = 0; i < 3 * WSTAT_TEST_LEN; i++)
+        wstat_push(8000000 + (int32_t)(i * 2654435761u >> 29));
+    wstat_reference(&max, &min, &mean, &std);
+    naive = sqrt(fabs((double)wstat_test.sum2 / wstat_test.count -
+                      ((double)wstat_test.sum / wstat_test.count) * ((double)wstat_test.sum / wstat_test.count)));
+    TEST_LOG("offset_std ref=%.6f wstat=%.6f naive=%.6f\n", std, WSTAT_Std(&wstat_test), naive);
+    TEST_CHECK(fabs(WSTAT_Std(&wstat_test) - std) < 1e-5 * std);
+
+    WSTAT_Init(&wstat_test, wstat_ring, WSTAT_TEST_LEN);
+    t0 = test_now();
+    for (uint32_t i = 0; i < n; i++)
+        wstat_push((int32_t)(i * 2654435761u) >> 8);
+    t1 = test_now();
+
+    // 500SPS的合成ECG抽取2倍后进入窗口，与同一时间段内全速率样本的峰峰值比较
+    SYNTH_DefaultParam(&p, 500.0f);
+    SYNTH_Init(&s, &p);
+    FIR_Decim_Init(&wstat_decim, 2);
+    WSTAT_Init(&wstat_test, wstat_ring, WSTAT_TEST_LEN);
+    for (uint32_t i = 0; i < 4 * 2 * WSTAT_TEST_LEN; i++)
+    {
+        int32_t c = SYNTH_ToCounts(SYNTH_Next(&s));
+#if ECG_USE_FIXED_POINT
+        int32_t y;
+
+        if (FIR_Decim_ProcessQ31(&wstat_decim, (int32_t)((uint32_t)c << 8), &y))
+            wstat_push(y >> 8);
+#else
+        float y;
+
+        if (FIR_Decim_Process(&wstat_decim, (float)c, &y))
+            wstat_push((int32_t)y);
+#endif
+        if (i >= 3 * 2 * WSTAT_TEST_LEN)
+        {
+            full_max = c > full_max ? c : full_max;
+            full_min = c < full_min ? c : full_min;
+        }
+    }
+
+    TEST_LOG("mismatch=%u sizeof=%u saved=%u ns_per_push=%.1f\n", mismatch, (unsigned)sizeof(WSTAT_t),
+             (unsigned)(WSTAT_MAX_LEN * sizeof(int32_t)), (t1 - t0) / n);
+    TEST_LOG("p2p full_rate=%d decim2=%d ratio=%.3f\n", full_max - full_min,
+             WSTAT_Max(&wstat_test) - WSTAT_Min(&wstat_test),
+             (double)(WSTAT_Max(&wstat_test) - WSTAT_Min(&wstat_test)) / (full_max - full_min));
+    TEST_CHECK(mismatch == 0);
+    TEST_CHECK(WSTAT_Max(&wstat_test) - WSTAT_Min(&wstat_test) > 0.9 * (full_max - full_min));
+    wstat_check_modes();
+}
@@ -94,6 +94,20 @@ LoopFillZerobss:
   cmp r2, r4
   bcc FillZerobss
 
+/* Zero fill the DSP buffers in CCM RAM. */
+  ldr r2, =_sdsp_bss
+  ldr r4, =_edsp_bss
+  movs r3, #0
+  b LoopFillZeroDsp
+
+FillZeroDsp:
+  str  r3, [r2]
+  adds r2, r2, #4
+
+LoopFillZeroDsp:
+  cmp r2, r4
+  bcc FillZeroDsp
+
 /* Call static constructors */
     bl __libc_init_array
 /* Call the application's entry point.*/